@@ -1,12 +1,15 @@
 #pragma once
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 #include <map>
+#include "../operators/csr_operator.h"
 
 class ConfigReader
 {
 public:
-    ConfigReader() : tolerance_(1e-6), maxIterations_(1000), size_(0) {}
+    ConfigReader() : tolerance_(1e-6), maxIterations_(1000), size_(0), threads_(0) {}
     bool loadConfig(const std::string &filename);
 
     // 添加手动设置方法
@@ -16,26 +19,64 @@ public:
     void setMatrixSize(int size);
     void setMatrixA(const std::vector<std::vector<double> > &A);
     void setVectorB(const std::vector<double> &b);
+    void setThreads(int threads);
+    void setAffinity(const std::string &affinity);
 
     // 获取求解器配置
     std::string getSolverType() const;
     double getTolerance() const;
     int getMaxIterations() const;
+    // 时间分块每组的扫描次数 (Solver.temporal_sweeps)，未配置时为 1 (不分块)
+    int getTemporalSweeps() const;
+
+    // 获取并行配置 ([Parallel] 节可省略)
+    int getThreads() const;         // 0 表示使用默认线程数
+    std::string getAffinity() const; // none/compact/scatter
+
+    // 获取分解缓存配置 ([Cache] 节可省略)
+    std::string getCacheDirectory() const; // 空表示不使用缓存
+    uint64_t getCacheMaxBytes() const;     // 由 max_size_mb 换算，0 表示不限
+    int getCacheMaxEntries() const;        // 0 表示不限
 
     // 获取矩阵配置
+    // 矩阵自由算子类型 (poisson1d/poisson2d/poisson3d)，未配置时为空
+    std::string getOperatorType() const;
+    int getGridSize() const;
+    // 显式矩阵的存储格式 (csr/compressed/dia/ell/sell/auto/bench)，未配置时为 csr
+    std::string getMatrixFormat() const;
     int getMatrixSize() const;
     std::vector<std::vector<double> > getMatrixA() const;
+    // 直接解析为 CSR (并行、丢弃零元素)，失败时输出错误并返回 false
+    bool getSparseMatrixA(CsrMatrix &A) const;
     std::vector<double> getVectorB() const;
+    // 多个右端项以分号分隔，例如 b = 1,2,3,4; 4,3,2,1；未配置 b 时 rhs 为空
+    // 任一右端项解析失败时输出错误并返回 false，rhs 被清空
+    bool getRightHandSides(std::vector<std::vector<double> > &rhs) const;
 
 private:
-    std::vector<double> parseNumberList(const std::string &str, char delimiter) const;
-    std::map<std::string, std::string> configMap_;
+    // 配置值在 text_ 中的区间
+    struct Span
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    // 取出配置值，缺失时抛出 std::out_of_range
+    std::string value(const std::string &key) const;
+    // 取得配置值区间而不复制，缺失时返回 false
+    bool findValue(const std::string &key, const char *&begin, const char *&end) const;
+
+    // 整个配置文件的内容：支持时只读映射文件，否则读入堆上的缓冲区；副本共享同一份内容
+    std::shared_ptr<const char> text_;
+    std::map<std::string, Span> configMap_;
 
     // 添加直接存储数据的成员
     std::string solverType_;
     double tolerance_;
     int maxIterations_;
     int size_;
+    int threads_;
+    std::string affinity_ = "none";
     std::vector<std::vector<double> > A_;
     std::vector<double> b_;
     bool useDirectData_ = false;
@@ -0,0 +1,69 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// 线性算子 A 的抽象，迭代法只通过它访问系数矩阵
+// 子类至少需要提供逐行内积与对角元，apply 等整体运算默认按行并行实现
+class LinearOperator
+{
+public:
+    virtual ~LinearOperator() = default;
+
+    // 方程组规模 n
+    virtual int size() const = 0;
+    // 对角元 A[i][i]
+    virtual double diagonal(int i) const = 0;
+    // 第 i 行与 x 的内积 (含对角项)，供 SOR 逐行原地更新
+    virtual double rowDot(int i, const double *x) const = 0;
+    // 第 i 行与 n×m 行交错块 X 的 m 个列分别求内积，结果写入 out[0..m)
+    virtual void rowDotBlock(int i, const double *X, int m, double *out) const = 0;
+    // 将第 i 行展开为稠密形式写入 row[0..n)，供直接法分解使用
+    virtual void copyRow(int i, double *row) const = 0;
+
+    // y = A x
+    virtual void apply(const double *x, double *y) const;
+    // Y = A X，X 与 Y 均为 n×m 行交错块
+    virtual void applyBlock(const double *X, double *Y, int m) const;
+    // 第 i 行非对角元绝对值之和，用于对角占优检查；默认展开整行计算
+    virtual double offDiagonalAbsSum(int i) const;
+    // 对 [begin, end) 行按行号顺序做 SOR 原地更新 x_i += ω (b_i - (A x)_i) / diag_i，返回最大的 |增量|
+    // 默认逐行调用 rowDot，压缩格式等可改写以省去逐行的虚调用与分派
+    virtual double sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                            double *x) const;
+    // sorSweep 的多列版本：X、B 为 n×m 行交错块，diff[q] 与第 q 列本次的最大 |增量| 取较大者
+    // 默认逐行调用 rowDotBlock，每个系数只读取一次，作用到全部 m 列
+    virtual void sorSweepBlock(int begin, int end, const double *B, const double *diag, double omega,
+                               double *X, int m, double *diff) const;
+    // 对 [begin, end) 行做 Jacobi 更新 xNew_i = x_i + (b_i - (A x)_i) / diag_i (行间并行)，返回最大的 |增量|
+    virtual double jacobiSweep(int begin, int end, const double *b, const double *diag, const double *x,
+                               double *xNew) const;
+    // 半带宽 w：所有非零元满足 |i - j| ≤ w，用于时间分块；未知时返回 -1
+    virtual int bandwidth() const { return -1; }
+
+    // 一次扫描需读取的系数数据字节数 (矩阵自由算子为 0) 与单列 apply 的浮点运算次数
+    // 仅用于性能报告中的带宽与运算量估计
+    virtual double matrixBytes() const = 0;
+    virtual double applyFlops() const = 0;
+
+    // 算子名称，用于输出
+    virtual std::string name() const = 0;
+};
+
+// 显式稠密矩阵，引用外部存储的行
+class DenseOperator : public LinearOperator
+{
+public:
+    explicit DenseOperator(const std::vector<std::vector<double> > &A) : A_(A) {}
+
+    int size() const override { return A_.size(); }
+    double diagonal(int i) const override { return A_[i][i]; }
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    double matrixBytes() const override { return 8.0 * size() * size(); }
+    double applyFlops() const override { return 2.0 * size() * size(); }
+    std::string name() const override { return "dense"; }
+
+private:
+    const std::vector<std::vector<double> > &A_;
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "../operators/csr_operator.h"
+
+// 解析配置文件中的文本矩阵 "a,b,c; d,e,f; ..."，直接在原始缓冲区上生成 CSR
+// 先并行查找行分隔符 ';'，再按行并行解析，零元素在解析时丢弃，不构造中间字符串
+// 每行须恰好有 n 个元素，失败时 error 给出出错行
+bool parseCsrMatrix(const char *begin, const char *end, int n,
+                    CsrMatrix &out, std::string &error);
+
+// 解析以 ',' 分隔的一行数，空白与空项跳过
+bool parseNumberRow(const char *begin, const char *end,
+                    std::vector<double> &out, std::string &error);
+
+// 从 p 开始解析一个浮点数 (跳过前导空白)，成功时 p 移到数字之后
+// 常见的短小数走精确的快速路径，其余交给 strtod，结果与 strtod 一致
+bool parseDouble(const char *&p, const char *end, double &value);
@@ -1,5 +1,11 @@
 #pragma once
+#include <functional>
+#include <memory>
 #include <vector>
+#include "linear_operator.h"
+#include "../utils/parallel.h"
+
+class UpdatedOperator;
 
 class Solver
 {
@@ -9,21 +15,131 @@ public:
     // 设置方程组 Ax = b
     void setEquation(const std::vector<std::vector<double> > &A,
                      const std::vector<double> &b);
+    // 矩阵自由模式：只提供算子 A，不存储系数矩阵 (直接法需逐行展开算子)
+    void setOperator(std::shared_ptr<const LinearOperator> op,
+                     const std::vector<double> &b);
+    const LinearOperator &getOperator() const { return *op_; }
+    // 只替换右端项 b (长度为 n)，保留已有的分解等预处理结果
+    void setRightHandSide(const double *b);
+
+    // 低秩更新 A ← A + U Vᵀ，U、V 均为 n×k 行交错存储 (U[i*k + c])，b 不变
+    // 直接法在已有分解上做 Sherman–Morrison–Woodbury 修正，迭代法的下一次 solve 从上一次的解热启动
+    // setEquation 给出的矩阵原地修改；其余算子在其上叠加 U、V 因子 (UpdatedOperator)，不改动调用方的数据
+    bool updateLowRank(const std::vector<double> &U, const std::vector<double> &V, int k);
+    // 稀疏更新 A[rows[t]][cols[t]] += values[t]，按元素叠加；直接法按所涉及的行组成低秩修正
+    bool updateEntries(const std::vector<int> &rows, const std::vector<int> &cols,
+                       const std::vector<double> &values);
 
     // 求解方程
     virtual bool solve(std::vector<double> &x) = 0;
 
+    // 多右端项模式：B 与 X 均为 n×k 行交错存储 (B[i*k + c])
+    void setRightHandSides(const std::vector<double> &B, int k);
+    // 同时求解 k 个右端项；默认逐列调用 solve，迭代法改写为每次迭代只扫描一遍 A
+    virtual bool solveBlock(std::vector<double> &X);
+    // 各列收敛所用的迭代次数 (直接法为 0)
+    const std::vector<int> &getColumnIterations() const { return columnIterations_; }
+    // 各列是否收敛 (1 为收敛)，由求解过程直接记录，不依赖迭代次数推断
+    const std::vector<char> &getColumnConverged() const { return columnConverged_; }
+    // 最近一次 solve 的迭代次数 (直接法为 0)
+    int getIterations() const { return iterations_; }
+    // 最近一次 solve/solveBlock 是否因矩阵奇异 (直接法) 或对角元接近0 (迭代法) 而未能求解
+    bool isSingular() const { return singular_; }
+
     // 设置迭代精度和最大迭代次数
     void setParameters(double tolerance, int maxIterations);
+    double getTolerance() const { return tolerance_; }
+    int getMaxIterations() const { return maxIterations_; }
+
+    // 带状矩阵的时间分块 (仅迭代法的 solve)：每 sweeps 次扫描为一组，在缓存大小的行块上按波前
+    // 连续推进 sweeps 层再处理下一块，组末检查一次收敛；迭代结果与逐次扫描相同，迭代次数按组取整
+    // sweeps ≤ 1 时关闭 (默认)；矩阵不是带状或带宽相对缓存过大时自动退回逐次扫描
+    void setTemporalBlocking(int sweeps) { blockSweeps_ = sweeps; }
+    int getTemporalBlocking() const { return blockSweeps_; }
+    // 最近一次 solve 时间分块的行块大小，0 表示未分块
+    int getTemporalTileRows() const { return tileRows_; }
 
     // 检查矩阵是否可解
     bool checkSolvability() const;
 
+    // 最近一次 solve/solveBlock/factorize 的访存字节数与浮点运算次数估计，用于性能报告
+    struct WorkEstimate
+    {
+        double bytes = 0.0;
+        double flops = 0.0;
+    };
+    const WorkEstimate &getWorkEstimate() const { return work_; }
+
+    // 是否输出迭代过程信息
+    void setVerbose(bool verbose) { verbose_ = verbose; }
+
 protected:
+    // A_ 的各行与 b_ 按静态行划分由对应线程首次写入，见 setEquation
     std::vector<std::vector<double> > A_;
-    std::vector<double> b_;
+    NumaVector b_;
+    // 迭代法通过 op_ 访问 A；显式矩阵时为引用 A_ 的 DenseOperator
+    std::shared_ptr<const LinearOperator> op_;
     double tolerance_ = 1e-6;
     int maxIterations_ = 1000;
+    int iterations_ = 0;
+    bool singular_ = false;
+    bool verbose_ = true;
+
+    WorkEstimate work_;
+    // 记录一次扫描 m 列的工作量：系数数据读一次，每列读写 vectors 个长度为 n 的向量，
+    // 每行每列另有 flopsPerRow 次运算
+    void addSweepWork(int m, int vectors, double flopsPerRow);
+    // 时间分块的一组 levels 次扫描：系数与向量只从内存读一次，运算量按 levels 次计
+    void addTemporalWork(int levels, int vectors, double flopsPerRow);
+
+    int blockSweeps_ = 1;
+    int tileRows_ = 0;
+    // 时间分块的行块大小：每个线程约 kTemporalCacheBytes 的缓存容纳 A 与 vectors 个向量的
+    // 行块加上各层之间 (levels-1)·w 行的错位；错位超过行块本身时分块无益，返回 0
+    int temporalTileRows(int bandwidth, int levels, int vectors, int threads) const;
+    // 按波前顺序做 levels 层扫描：第 t 层 (从 0 计) 处理第 k 块的 [kT - t·w, (k+1)T - t·w) 行 (截取到 [0, n))，
+    // 由 sweep(t, begin, end) 完成。第 t 层第 i 行只用到第 t-1 层的 [i-w, i+w] 行与第 t 层更早的行，
+    // 两者在此顺序下都已算出且尚未被更高层覆盖，因此 Jacobi 可在两个向量间交替，SOR 可原地更新
+    static void wavefront(int n, int bandwidth, int levels, int tile,
+                          const std::function<void(int, int, int)> &sweep);
+
+    // 系数矩阵变化时调用，子类在此丢弃分解等缓存
+    virtual void invalidate() {}
+    // updateLowRank 修改 A 之后调用；默认丢弃缓存，直接法可改为修正已有分解
+    virtual void lowRankUpdate(const std::vector<double> &U, const std::vector<double> &V, int k);
+    // updateEntries 修改 A 之后调用；默认丢弃缓存
+    virtual void entriesUpdate(const std::vector<int> &rows, const std::vector<int> &cols,
+                               const std::vector<double> &values);
+
+    // updateLowRank 创建的叠加算子，与 op_ 指向同一对象时可继续累加修改
+    std::shared_ptr<UpdatedOperator> updated_;
+    // 取得叠加算子，op_ 尚未叠加时先创建
+    UpdatedOperator &updatedOperator();
+    // 上一次 solve 的解；A 被更新后迭代法以它为初始值
+    std::vector<double> lastSolution_;
+    bool warmStart_ = false;
+    // 迭代法的初始值：热启动时取上一次的解，否则沿用 x (长度不足补 0)
+    void initialGuess(std::vector<double> &x, int n);
+    void rememberSolution(const std::vector<double> &x);
+
+    // 多右端项数据，按行交错存储
+    NumaVector B_;
+    int rhsCount_ = 0;
+    std::vector<int> columnIterations_;
+    std::vector<char> columnConverged_;
+
+    // 从行交错块中删除 keep[c] 为 0 的列，宽度由 width 变为保留的列数
+    static void dropColumns(NumaVector &block, int n, int width, const std::vector<char> &keep);
+    // 将工作块 W 中的活动列 (对应原始列号 cols) 写回 X
+    void storeColumns(std::vector<double> &X, const std::vector<int> &cols,
+                      const NumaVector &W, int n) const;
+    // 第 iter 次迭代后 diff[q] 小于精度的列视为收敛：记录收敛标志，写回 X 并从 W、Bw 中移除，返回剩余活动列数
+    int retireColumns(std::vector<double> &X, std::vector<int> &cols,
+                      const std::vector<double> &diff, int iter,
+                      NumaVector &W, NumaVector &Bw, int n);
+
+    // 读取对角元并检查是否接近0，成功返回 true，结果同时记入 singular_
+    bool loadDiagonal(NumaVector &diag);
 
     // 检查矩阵维度
     bool checkDimensions() const;
@@ -0,0 +1,116 @@
+/*
+ * MatrixKill C API
+ *
+ * 求解器句柄在多次调用之间保持存活：直接法的 LU 分解在系数矩阵不变时
+ * 只计算一次，之后每次求解只做回代。系数矩阵以调用方持有的稠密或 CSR
+ * 缓冲区传入，库内不复制，调用方须保证其在句柄使用期间有效且不被修改；
+ * 修改内容后须重新调用 mk_solver_set_dense/mk_solver_set_csr，少量修改
+ * 也可改用 mk_solver_update_lowrank/mk_solver_update_entries 而不修改缓冲区。
+ */
+#ifndef MATRIXKILL_H
+#define MATRIXKILL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define MK_VERSION_MAJOR 1
+#define MK_VERSION_MINOR 4
+
+    typedef struct mk_solver mk_solver;
+
+    typedef enum
+    {
+        MK_SOLVER_JACOBI = 0,
+        MK_SOLVER_GAUSS = 1,
+        MK_SOLVER_SOR = 2
+    } mk_solver_type;
+
+    typedef enum
+    {
+        MK_OK = 0,
+        MK_ERROR_INVALID_ARGUMENT = 1, /* 参数为空或维度不合法 */
+        MK_ERROR_NO_MATRIX = 2,        /* 尚未设置系数矩阵 */
+        MK_ERROR_NOT_CONVERGED = 3,    /* 迭代法达到最大迭代次数，x 为最后一次迭代值 */
+        MK_ERROR_SINGULAR = 4,         /* 矩阵奇异或对角元为0 */
+        MK_ERROR_INTERNAL = 5          /* 内存不足等内部错误 */
+    } mk_status;
+
+    typedef struct
+    {
+        int iterations;       /* 迭代次数，直接法为 0 */
+        int converged;        /* 1 表示满足收敛精度 */
+        double residual_norm; /* ||Ax - b||_2 */
+        double setup_ms;      /* 本次调用中分解等预处理耗时，复用时为 0 */
+        double solve_ms;      /* 求解耗时 */
+    } mk_stats;
+
+    /* 创建/销毁求解器句柄 */
+    mk_solver *mk_solver_create(mk_solver_type type);
+    void mk_solver_destroy(mk_solver *solver);
+
+    /* 设置收敛精度、最大迭代次数与 SOR 松弛因子 (omega <= 0 表示保持不变) */
+    mk_status mk_solver_set_parameters(mk_solver *solver, double tolerance,
+                                       int max_iterations, double omega);
+
+    /*
+     * 带状矩阵的时间分块 (仅迭代法)：每 sweeps 次扫描为一组，在缓存大小的行块上连续推进，
+     * 组末检查一次收敛，解与逐次扫描相同；sweeps <= 1 关闭 (默认)
+     */
+    mk_status mk_solver_set_temporal_blocking(mk_solver *solver, int sweeps);
+
+    /*
+     * 在 directory 下缓存 LU 分解 (仅直接法有效，其余求解器忽略)，跨进程复用：
+     * 分解前按系数矩阵内容与求解精度计算哈希，命中时映射缓存文件而不重新分解
+     * 缓存总大小超过 max_bytes 或项数超过 max_entries 时删除最久未使用的项，0 表示不限；
+     * directory 为 NULL 时关闭缓存
+     */
+    mk_status mk_solver_set_cache(mk_solver *solver, const char *directory,
+                                  unsigned long long max_bytes, int max_entries);
+
+    /* 稠密矩阵：行主序，第 i 行起始于 a + i*lda (lda >= n) */
+    mk_status mk_solver_set_dense(mk_solver *solver, int n, const double *a, int lda);
+
+    /* CSR 矩阵：row_ptr 长度 n+1，col_idx/values 长度 row_ptr[n]，下标从 0 开始 */
+    mk_status mk_solver_set_csr(mk_solver *solver, int n, const int *row_ptr,
+                                const int *col_idx, const double *values);
+
+    /* 求解 Ax = b；x 长度为 n，作为迭代法初值传入并返回解，stats 可为 NULL */
+    mk_status mk_solver_solve(mk_solver *solver, const double *b, double *x, mk_stats *stats);
+
+    /*
+     * 同时求解 k 个右端项，B 与 X 为 n×k 行交错存储 (B[i*k + c])
+     * stats 可为 NULL，否则须有 k 个元素，每列单独记录
+     */
+    mk_status mk_solver_solve_block(mk_solver *solver, int k, const double *B,
+                                    double *X, mk_stats *stats);
+
+    /*
+     * 低秩更新 A ← A + U Vᵀ，U、V 为 n×k 行交错存储 (U[i*k + c])，调用方的矩阵缓冲区不被修改
+     * 直接法在已有 LU 分解上做 Woodbury 修正，后续求解约 O(n² + nk)；
+     * 迭代法的下一次 mk_solver_solve 以上一次的解为初值，忽略传入的 x
+     */
+    mk_status mk_solver_update_lowrank(mk_solver *solver, int k, const double *U, const double *V);
+
+    /* 稀疏更新 A[rows[t]][cols[t]] += values[t] (t < count)，同一行的修改合并为秩 1 */
+    mk_status mk_solver_update_entries(mk_solver *solver, int count, const int *rows,
+                                       const int *cols, const double *values);
+
+    /*
+     * 批量求解 count 个同规模的小方程组 (1 <= n <= 16)，不需要求解器句柄
+     * A 为 count 个行主序 n×n 矩阵依次存放，b、x 为 count 个长度为 n 的向量依次存放
+     * status 可为 NULL，否则 status[s] 为 1 表示第 s 个方程组奇异 (其解置 0)
+     * 存在奇异方程组时返回 MK_ERROR_SINGULAR，其余方程组的解仍然有效
+     */
+    mk_status mk_solve_batched(int n, int count, const double *A, const double *b,
+                               double *x, unsigned char *status);
+
+    /* 返回状态码的描述文字 */
+    const char *mk_status_string(mk_status status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MATRIXKILL_H */
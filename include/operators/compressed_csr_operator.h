@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "../core/linear_operator.h"
+#include "../utils/parallel.h"
+
+// 压缩存储的 CSR 矩阵，用于带宽受限的 Jacobi/SOR 扫描，计算时边读边解码
+// 列号：每行首列存 32 位，其后存与前一列的 16 位差值；差值超过 16 位时写入 0 作为转义，
+//       随后两个 16 位字给出完整列号 (同一行列号严格递增，差值不会为 0)
+// 数值：不同值不超过 256/65536 个时存 8/16 位字典下标，否则存原始 double
+// 常见的带状矩阵每个非零元约 3 字节，而 CSR 为 12 字节
+class CompressedCsrOperator : public LinearOperator
+{
+public:
+    enum class ValueMode
+    {
+        Dict8,
+        Dict16,
+        Raw
+    };
+
+    // 从 CSR 数组复制并压缩，同一行的列号可以无序，重复的列号合并相加
+    // useDictionary 为 false 时数值总是按原始 double 存储
+    CompressedCsrOperator(int n, const int *rowPtr, const int *colIdx, const double *values,
+                          bool useDictionary = true);
+
+    int size() const override { return n_; }
+    double diagonal(int i) const override;
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    double offDiagonalAbsSum(int i) const override;
+    void apply(const double *x, double *y) const override;
+    double sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                    double *x) const override;
+    double jacobiSweep(int begin, int end, const double *b, const double *diag, const double *x,
+                       double *xNew) const override;
+    int bandwidth() const override;
+    double matrixBytes() const override;
+    double applyFlops() const override { return 2.0 * nonZeros(); }
+    std::string name() const override;
+
+    int nonZeros() const { return valPtr_[n_]; }
+    ValueMode valueMode() const { return mode_; }
+    int dictionarySize() const { return dictionary_.size(); }
+
+private:
+    using CodeVector16 = std::vector<uint16_t, DefaultInitAllocator<uint16_t> >;
+    using CodeVector8 = std::vector<uint8_t, DefaultInitAllocator<uint8_t> >;
+
+    int n_;
+    NumaIndexVector valPtr_;  // 第 i 行数值的起止位置，与 CSR 的 rowPtr 相同
+    NumaIndexVector idxPtr_;  // 第 i 行列号差值流的起始位置
+    NumaIndexVector rowBase_; // 第 i 行的首列号
+    CodeVector16 deltas_;
+    ValueMode mode_ = ValueMode::Raw;
+    std::vector<double> dictionary_;
+    CodeVector8 codes8_;
+    CodeVector16 codes16_;
+    NumaVector values_;
+
+    // 依次以 (列号, 数值) 调用 fn 访问第 i 行，values 为数值解码器
+    template <typename Values, typename Fn>
+    void visitRow(int i, const Values &values, Fn &&fn) const;
+    // 按数值存储方式分派，fn 以对应的解码器调用
+    template <typename Fn>
+    void dispatch(Fn &&fn) const;
+};
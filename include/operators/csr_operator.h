@@ -0,0 +1,51 @@
+#pragma once
+#include <memory>
+#include "../core/linear_operator.h"
+#include "../utils/parallel.h"
+
+// 自有存储的 CSR 矩阵，各数组按行划分由对应线程首次写入
+struct CsrMatrix
+{
+    int n = 0;
+    NumaIndexVector rowPtr;
+    NumaIndexVector colIdx;
+    NumaVector values;
+};
+
+// 压缩稀疏行 (CSR) 格式的只读视图，不复制调用方的数组
+// rowPtr 长度为 n+1，colIdx/values 长度为 rowPtr[n]，下标从 0 开始
+class CsrOperator : public LinearOperator
+{
+public:
+    CsrOperator(int n, const int *rowPtr, const int *colIdx, const double *values)
+        : n_(n), rowPtr_(rowPtr), colIdx_(colIdx), values_(values) {}
+    // 持有矩阵的共享所有权，生命周期与算子一致
+    explicit CsrOperator(std::shared_ptr<const CsrMatrix> matrix)
+        : n_(matrix->n), rowPtr_(matrix->rowPtr.data()), colIdx_(matrix->colIdx.data()),
+          values_(matrix->values.data()), owner_(matrix) {}
+
+    int size() const override { return n_; }
+    double diagonal(int i) const override;
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    double offDiagonalAbsSum(int i) const override;
+    double sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                    double *x) const override;
+    double jacobiSweep(int begin, int end, const double *b, const double *diag, const double *x,
+                       double *xNew) const override;
+    int bandwidth() const override;
+    // 每个非零元 8 字节值 + 4 字节列号，另加行指针
+    double matrixBytes() const override { return 12.0 * nonZeros() + 4.0 * (n_ + 1); }
+    double applyFlops() const override { return 2.0 * nonZeros(); }
+    std::string name() const override { return "csr"; }
+
+    int nonZeros() const { return rowPtr_[n_]; }
+
+protected:
+    int n_;
+    const int *rowPtr_;
+    const int *colIdx_;
+    const double *values_;
+    std::shared_ptr<const CsrMatrix> owner_;
+};
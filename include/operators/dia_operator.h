@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include "../core/linear_operator.h"
+#include "../utils/parallel.h"
+
+// 对角线 (DIA) 格式：只存含非零元的对角线，每条对角线为长度 n 的连续数组
+// 第 d 条对角线偏移为 offsets_[d]，data_[d*n + i] = A[i][i + offsets_[d]]，越界处为 0
+// 带状矩阵没有列号开销且按行连续访问，SpMV 可直接向量化；对角线分散时填充率很高
+class DiaOperator : public LinearOperator
+{
+public:
+    // 从 CSR 数组构造，重复的列号相加
+    DiaOperator(int n, const int *rowPtr, const int *colIdx, const double *values);
+
+    // 统计 CSR 中含非零元的对角线条数，用于估算填充率
+    static int countDiagonals(int n, const int *rowPtr, const int *colIdx);
+
+    int size() const override { return n_; }
+    double diagonal(int i) const override;
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    void apply(const double *x, double *y) const override;
+    double sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                    double *x) const override;
+    double jacobiSweep(int begin, int end, const double *b, const double *diag, const double *x,
+                       double *xNew) const override;
+    int bandwidth() const override;
+    double matrixBytes() const override { return 8.0 * data_.size() + 4.0 * offsets_.size(); }
+    double applyFlops() const override { return 2.0 * data_.size(); }
+    std::string name() const override { return "dia"; }
+
+    int diagonals() const { return offsets_.size(); }
+
+private:
+    int n_;
+    std::vector<int> offsets_; // 递增排列
+    NumaVector data_;
+    int mainDiagonal_ = -1; // 主对角线在 offsets_ 中的序号，没有时为 -1
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "../core/linear_operator.h"
+#include "../utils/parallel.h"
+
+// ELLPACK 格式：每行补齐到最长行的长度 width_，按列主序存放 (第 k 个元素位于 k*n + i)
+// 相邻行的同一位置连续存放，SpMV 可跨行向量化；补齐元素值为 0、列号为本行，行长差异大时填充率高
+class EllOperator : public LinearOperator
+{
+public:
+    EllOperator(int n, const int *rowPtr, const int *colIdx, const double *values);
+
+    int size() const override { return n_; }
+    double diagonal(int i) const override;
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    void apply(const double *x, double *y) const override;
+    double sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                    double *x) const override;
+    double jacobiSweep(int begin, int end, const double *b, const double *diag, const double *x,
+                       double *xNew) const override;
+    int bandwidth() const override;
+    double matrixBytes() const override { return 12.0 * values_.size(); }
+    double applyFlops() const override { return 2.0 * values_.size(); }
+    std::string name() const override { return "ell"; }
+
+    int width() const { return width_; }
+
+private:
+    int n_;
+    int width_ = 0;
+    NumaIndexVector colIdx_;
+    NumaVector values_;
+};
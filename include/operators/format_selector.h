@@ -0,0 +1,41 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "csr_operator.h"
+
+// 显式矩阵存储格式的创建与自动选择 (csr/compressed/dia/ell/sell)
+class FormatSelector
+{
+public:
+    // 稀疏结构统计；各格式的填充率 = 存储的元素个数 (含补齐) / 非零元个数
+    struct Analysis
+    {
+        int n = 0;
+        long long nonZeros = 0;
+        int maxRowLength = 0;
+        double meanRowLength = 0.0;
+        int diagonals = 0;
+        double diaFill = 0.0;
+        double ellFill = 0.0;
+        double sellFill = 0.0;
+    };
+
+    static Analysis analyze(const CsrMatrix &A);
+    // 按稀疏结构选择格式，reason 给出依据
+    // 对角线集中时用 DIA；行较短时，行长均匀用 ELLPACK，否则块内补齐不多时用 SELL-C-σ；都不合适时用 CSR
+    // sequentialSweep 为 true (SOR 逐行原地扫描) 时不选列主序的 ELLPACK/SELL，其逐行访问跨度过大
+    static std::string choose(const Analysis &analysis, bool sequentialSweep, std::string &reason);
+    // 按名称创建算子，未知名称返回空指针
+    static std::shared_ptr<LinearOperator> create(const std::string &format,
+                                                  const std::shared_ptr<const CsrMatrix> &A);
+    // 依次构造各候选格式并计时几次 SpMV (sequentialSweep 时为 SOR 扫描)，返回最快的算子，其格式名写入 format
+    // times 记录各格式每次 SpMV 的毫秒数；填充率过高的格式不参与，以免构造时占用过多内存
+    static std::shared_ptr<LinearOperator> benchmark(const std::shared_ptr<const CsrMatrix> &A,
+                                                     const Analysis &analysis, bool sequentialSweep,
+                                                     std::vector<std::pair<std::string, double> > &times,
+                                                     std::string &format);
+    // 给定格式的填充率 (csr/compressed 为 1)
+    static double fillRatio(const Analysis &analysis, const std::string &format);
+};
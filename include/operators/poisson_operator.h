@@ -0,0 +1,38 @@
+#pragma once
+#include "../core/linear_operator.h"
+
+// 1D/2D/3D 泊松方程的二阶中心差分模板 (Dirichlet 边界，未乘 1/h²)
+// 网格每维 gridSize 个内点，未知量按 x 方向最快变化编号
+// 对角元为 2*dim，相邻网格点为 -1，系数不做存储，内存仅为 O(n) 的向量
+class PoissonOperator : public LinearOperator
+{
+public:
+    PoissonOperator(int dim, int gridSize);
+
+    int size() const override { return size_; }
+    double diagonal(int) const override { return 2.0 * dim_; }
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    double offDiagonalAbsSum(int i) const override;
+    // 最远的相邻点在最慢变化的方向上
+    int bandwidth() const override { return size_ > 1 ? stride_[dim_ - 1] : 0; }
+    double matrixBytes() const override { return 0.0; }
+    double applyFlops() const override { return (2.0 * dim_ + 1.0) * size_; }
+    std::string name() const override;
+
+    int dimension() const { return dim_; }
+    int gridSize() const { return grid_; }
+
+    // 解析 "poisson1d"/"poisson2d"/"poisson3d"，失败返回 0
+    static int parseDimension(const std::string &type);
+
+private:
+    int dim_;
+    int grid_;
+    int size_;
+    int stride_[3]; // 各方向相邻点的下标间隔
+
+    // 第 i 个点的相邻点下标，返回个数
+    int neighbors(int i, int *nb) const;
+};
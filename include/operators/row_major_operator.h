@@ -0,0 +1,27 @@
+#pragma once
+#include "../core/linear_operator.h"
+
+// 行主序连续存储的稠密矩阵只读视图，不复制调用方的数组
+// 第 i 行起始于 data + i*lda
+class RowMajorOperator : public LinearOperator
+{
+public:
+    RowMajorOperator(int n, const double *data, int lda)
+        : n_(n), data_(data), lda_(lda) {}
+
+    int size() const override { return n_; }
+    double diagonal(int i) const override { return row(i)[i]; }
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    double matrixBytes() const override { return 8.0 * n_ * n_; }
+    double applyFlops() const override { return 2.0 * n_ * n_; }
+    std::string name() const override { return "dense"; }
+
+private:
+    int n_;
+    const double *data_;
+    int lda_;
+
+    const double *row(int i) const { return data_ + static_cast<size_t>(i) * lda_; }
+};
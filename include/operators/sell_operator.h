@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "../core/linear_operator.h"
+#include "../utils/parallel.h"
+
+// SELL-C-σ 格式：每 σ 行为一个窗口，窗口内按行长降序排列，再每 C 行组成一块，
+// 块内补齐到该块最长行并按列主序存放 (块内第 k 个元素的 C 个行相邻)
+// 只在块内补齐，行长不均匀时填充率远低于 ELLPACK，同时保留跨行向量化
+// 窗口内的行被重排，按行区间扫描不连续，不提供 bandwidth，不参与时间分块
+class SellOperator : public LinearOperator
+{
+public:
+    static const int kChunk = 8;
+
+    SellOperator(int n, const int *rowPtr, const int *colIdx, const double *values, int sigma = 256);
+
+    // 不构造矩阵，只计算按 SELL-C-σ 存储时的元素个数 (含补齐)
+    static long long storedEntries(int n, const int *rowPtr, int sigma = 256);
+
+    int size() const override { return n_; }
+    double diagonal(int i) const override;
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    void apply(const double *x, double *y) const override;
+    double sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                    double *x) const override;
+    double matrixBytes() const override { return 12.0 * values_.size() + 8.0 * n_; }
+    double applyFlops() const override { return 2.0 * values_.size(); }
+    std::string name() const override;
+
+private:
+    int n_;
+    int sigma_;
+    std::vector<int> order_;    // order_[p] 为排序后第 p 行对应的原始行号，长度补齐到 C 的倍数
+    std::vector<int> position_; // position_[i] 为原始第 i 行排序后的位置
+    std::vector<int> chunkPtr_; // 第 c 块的数据起始位置，块长为 (chunkPtr_[c+1]-chunkPtr_[c])/C
+    NumaIndexVector colIdx_;
+    NumaVector values_;
+
+    // 按行长在 σ 窗口内排序，得到 order (补齐行记为 -1)
+    static void sortRows(int n, const int *rowPtr, int sigma, std::vector<int> &order);
+    // 以 (列号, 数值) 调用 fn 访问原始第 i 行 (含补齐元素，其值为 0)
+    template <typename Fn>
+    void visitRow(int i, Fn &&fn) const;
+};
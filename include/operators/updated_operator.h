@@ -0,0 +1,73 @@
+#pragma once
+#include <memory>
+#include <utility>
+#include <vector>
+#include "../core/linear_operator.h"
+
+// 在只读算子 base 上叠加修改：A' = base + S + U Vᵀ，不修改也不复制 base 的数据
+// S 为按行存放的稀疏增量，U、V 为 n×k 行交错的低秩因子；整体扫描仍调用 base 的内核，
+// 额外开销为 O(nnz(S) + n·k)
+// 单行访问 (rowDot、rowDotBlock、copyRow) 在 U 的该行非零时要展开 U Vᵀ 的整行，为 O(n·k)，不能用来组成扫描：
+// apply、applyBlock、sorSweep、sorSweepBlock、jacobiSweep 均已改写，整体扫描不会逐行调用它们。
+// 调试构建中 rowDot/rowDotBlock 若在并行区内被调用 (即被某个逐行并行的扫描使用) 会触发断言
+class UpdatedOperator : public LinearOperator
+{
+public:
+    explicit UpdatedOperator(std::shared_ptr<const LinearOperator> base);
+
+    // A' ← A' + U Vᵀ，U、V 为 n×k 行交错存储，追加到已有因子之后
+    void addLowRank(const double *U, const double *V, int k);
+    // A'[i][j] += value；同一位置多次修改会累加
+    void addEntry(int i, int j, double value);
+    // 低秩因子的秩与稀疏增量的元素个数
+    int rank() const { return rank_; }
+    int sparseEntries() const { return sparseCount_; }
+    const std::shared_ptr<const LinearOperator> &base() const { return base_; }
+
+    int size() const override { return base_->size(); }
+    double diagonal(int i) const override;
+    double rowDot(int i, const double *x) const override;
+    void rowDotBlock(int i, const double *X, int m, double *out) const override;
+    void copyRow(int i, double *row) const override;
+    void apply(const double *x, double *y) const override;
+    void applyBlock(const double *X, double *Y, int m) const override;
+    double sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                    double *x) const override;
+    void sorSweepBlock(int begin, int end, const double *B, const double *diag, double omega,
+                       double *X, int m, double *diff) const override;
+    double jacobiSweep(int begin, int end, const double *b, const double *diag, const double *x,
+                       double *xNew) const override;
+    // 有修改时不再按带状处理
+    int bandwidth() const override { return modified() ? -1 : base_->bandwidth(); }
+    double matrixBytes() const override;
+    double applyFlops() const override;
+    std::string name() const override { return base_->name() + "+update"; }
+
+private:
+    std::shared_ptr<const LinearOperator> base_;
+    int rank_ = 0;
+    std::vector<double> U_;
+    std::vector<double> V_;
+    // U_、V_ 的第 i 行是否非零
+    std::vector<char> uUsed_;
+    std::vector<char> vUsed_;
+    // slot_[i] 为第 i 行稀疏增量在 entries_ 中的序号，未修改的行为 -1
+    std::vector<int> slot_;
+    std::vector<std::vector<std::pair<int, double> > > entries_;
+    int sparseCount_ = 0;
+
+    bool modified() const { return rank_ > 0 || sparseCount_ > 0; }
+    double sparseDot(int i, const double *x) const;
+    // out[q] += 第 i 行稀疏增量与 n×m 块 X 第 q 列的内积
+    void sparseDotBlock(int i, const double *X, int m, double *out) const;
+    // w = Vᵀx，长度为 rank_
+    void projectV(const double *x, double *w) const;
+    // W = VᵀX，rank_×m 行主序
+    void projectVBlock(const double *X, int m, double *W) const;
+    // U 的第 i 行与 w 的内积
+    double lowRankDot(int i, const double *w) const;
+    // (U Vᵀ) 第 i 行与 x 的内积，串行 O(n·k)，仅供单行访问
+    double lowRankRowDot(int i, const double *x) const;
+    // out[q] += U 的第 i 行与 W 第 q 列的内积
+    void lowRankDotBlock(int i, const double *W, int m, double *out) const;
+};
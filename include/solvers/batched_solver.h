@@ -0,0 +1,28 @@
+#pragma once
+
+// 批量求解大量同规模的小方程组 (n ≤ kMaxSize)
+// 每种 n 有一份编译期展开的内核：n ≤ 3 用 Cramer 法则，其余为列主元 LU；
+// kLanes 个方程组按结构数组 (SoA) 排成一组，同一条指令同时处理各通道，组之间并行
+class BatchedSolver
+{
+public:
+    static const int kMaxSize = 16;
+    static const int kLanes = 8;
+
+    // 主元绝对值不超过 pivotTolerance·max|a_ij| (n ≤ 3 时行列式不超过 pivotTolerance·max|a_ij|ⁿ) 的方程组视为奇异，
+    // 判据是相对的，A 整体缩放不改变结论
+    explicit BatchedSolver(double pivotTolerance = 1e-12) : pivotTolerance_(pivotTolerance) {}
+
+    // 数组结构 (AoS) 输入：A 为 count 个行主序 n×n 矩阵依次存放，b、x 为 count 个长度为 n 的向量依次存放
+    // status 可为 nullptr，否则 status[s] 为 0 表示成功、1 表示奇异 (此时 x 置 0)
+    // 返回奇异方程组的个数，n 不在 [1, kMaxSize] 内时返回 -1
+    int solve(int n, int count, const double *A, const double *b, double *x,
+              unsigned char *status = nullptr) const;
+
+    // 结构数组 (SoA) 输入：A[(i*n + j)*count + s]、b[i*count + s]、x[i*count + s]，省去转置
+    int solveSoA(int n, int count, const double *A, const double *b, double *x,
+                 unsigned char *status = nullptr) const;
+
+private:
+    double pivotTolerance_;
+};
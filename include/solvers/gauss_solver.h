@@ -1,8 +1,63 @@
 #pragma once
 #include "../core/solver.h"
+#include "../utils/factor_cache.h"
 
 class GaussSolver : public Solver
 {
 public:
     bool solve(std::vector<double> &x) override;
-};
\ No newline at end of file
+
+    // 列主元 LU 分解 PA = LU；结果保留到系数矩阵变化为止，多次求解只做回代
+    bool factorize();
+    bool isFactorized() const { return factorized_; }
+    // 设置磁盘缓存：factorize 先按 A 与设置的哈希查找，命中时直接映射缓存的 LU，未命中时分解后写入
+    void setFactorCache(std::shared_ptr<FactorCache> cache) { cache_ = std::move(cache); }
+    // 最近一次 factorize 是否取自缓存
+    bool factorLoaded() const { return cached_ != nullptr; }
+    // 最近一次 factorize 未命中缓存时，分解结果是否成功写入缓存
+    bool factorStored() const { return stored_; }
+    // 当前叠加在分解之上的低秩修正的秩 (0 表示分解与 A 一致)
+    int updateRank() const { return rank_; }
+
+protected:
+    void invalidate() override
+    {
+        factorized_ = false;
+        rank_ = 0;
+        cached_.reset();
+        stored_ = false;
+    }
+    // 已有分解时用 Woodbury 公式吸收更新，累计的秩过大或修正矩阵奇异时改为下次求解重新分解
+    void lowRankUpdate(const std::vector<double> &U, const std::vector<double> &V, int k) override;
+    // 稀疏更新：每个涉及的行 i 贡献一项 e_i d_iᵀ，只在已有分解时才展开为 U、V 交给 lowRankUpdate
+    void entriesUpdate(const std::vector<int> &rows, const std::vector<int> &cols,
+                       const std::vector<double> &values) override;
+
+    // 用 LU 求解 A0 x = rhs，rhs 按原始行号索引，x 不能与 rhs 重叠
+    void substitute(const double *rhs, double *x) const;
+    // 分解 cap_ = I + VᵀZ，成功返回 true
+    bool factorizeCapacitance();
+
+    // L (单位下三角，不存对角) 与 U 合并存放，行主序 n×n
+    std::vector<double> lu_;
+    // perm_[i] 为分解后第 i 行对应的原始行号
+    std::vector<int> perm_;
+    bool factorized_ = false;
+    // 回代使用的 LU 与主元顺序：指向 lu_/perm_，或缓存命中时指向映射的文件
+    const double *luData_ = nullptr;
+    const int *permData_ = nullptr;
+    std::shared_ptr<FactorCache> cache_;
+    std::shared_ptr<const FactorCache::Entry> cached_;
+    bool stored_ = false;
+
+    // 参与缓存键的求解器设置
+    std::string cacheSettings() const;
+
+    // Woodbury 修正 A = A0 + U Vᵀ，A0 为 lu_ 分解的矩阵
+    // Z_ = A0⁻¹U 与 V_ 为 n×rank_ 行交错存储，cap_ 为 rank_×rank_ 的 I + VᵀZ 的 LU，capPerm_ 为其主元
+    std::vector<double> Z_;
+    std::vector<double> V_;
+    std::vector<double> cap_;
+    std::vector<int> capPerm_;
+    int rank_ = 0;
+};
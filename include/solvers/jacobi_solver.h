@@ -5,4 +5,5 @@ class JacobiSolver : public Solver
 {
 public:
     bool solve(std::vector<double> &x) override;
+    bool solveBlock(std::vector<double> &X) override;
 };
\ No newline at end of file
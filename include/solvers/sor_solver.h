@@ -6,6 +6,8 @@ class SORSolver : public Solver
 public:
     SORSolver(double omega = 1.5) : omega_(omega) {} // 默认松弛因子为1.5
     bool solve(std::vector<double> &x) override;
+    bool solveBlock(std::vector<double> &X) override;
+    void setOmega(double omega) { omega_ = omega; }
 
 private:
     double omega_; // 松弛因子
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "../core/linear_operator.h"
+
+// 跨进程复用的分解结果磁盘缓存
+// 每项为目录下的一个 <键>.mklu 文件：64 字节文件头、主元顺序 (int32 × n)、行主序 n×n 的 LU 因子，
+// 命中时只读映射文件，因子直接在映射内存上使用，不复制也不重新分解
+// 键为 A 的内容与求解器设置的 128 位哈希；总大小或项数超出上限时按最近使用时间淘汰
+class FactorCache
+{
+public:
+    struct Key
+    {
+        uint64_t lo = 0;
+        uint64_t hi = 0;
+        std::string hex() const;
+    };
+
+    // 只读映射的一项 LU 分解，生命周期内映射一直有效
+    class Entry
+    {
+    public:
+        ~Entry();
+        Entry(const Entry &) = delete;
+        Entry &operator=(const Entry &) = delete;
+
+        int size() const { return n_; }
+        const int *perm() const { return perm_; }
+        const double *lu() const { return lu_; }
+
+    private:
+        friend class FactorCache;
+        Entry() = default;
+
+        void *address_ = nullptr;
+        size_t length_ = 0;
+        int n_ = 0;
+        const int *perm_ = nullptr;
+        const double *lu_ = nullptr;
+    };
+
+    // maxBytes 为 0 时不限总大小，maxEntries 为 0 时不限项数
+    explicit FactorCache(const std::string &directory, uint64_t maxBytes = 0, int maxEntries = 0);
+
+    // 逐行展开算子计算内容哈希 (按行并行，结果与线程数无关)，settings 描述影响分解结果的求解器设置
+    static Key hash(const LinearOperator &op, const std::string &settings);
+
+    // 查找并映射一项，未命中、文件损坏或维度不符时返回 nullptr；命中时刷新其使用时间
+    std::shared_ptr<const Entry> load(const Key &key, int n) const;
+    // 写入一项 (必要时逐级创建目录，先写临时文件再改名，并发进程不会读到半个文件)，随后按上限淘汰
+    // 单项超过总大小上限或写入失败时向 cerr 说明原因并返回 false
+    bool store(const Key &key, int n, const int *perm, const double *lu);
+    // 按最近使用时间从旧到新删除，直到满足上限 (keep 为刚写入的项，不删除)，返回删除的项数
+    int evict(const Key *keep = nullptr);
+
+    const std::string &directory() const { return directory_; }
+
+private:
+    std::string directory_;
+    uint64_t maxBytes_;
+    int maxEntries_;
+
+    std::string path(const Key &key) const;
+};
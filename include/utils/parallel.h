@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 线程绑定策略
+enum class AffinityMode
+{
+    None,    // 不绑定，由操作系统调度
+    Compact, // 依次填满一个 NUMA 节点后再使用下一个
+    Scatter  // 线程轮流分布到各个 NUMA 节点
+};
+
+// 解析绑定策略名称 (none/compact/scatter)，失败返回 false
+bool parseAffinityMode(const std::string &name, AffinityMode &mode);
+const char *affinityModeName(AffinityMode mode);
+
+// 设置线程数 (<=0 表示保持默认) 并按策略绑定线程，需在首次并行计算前调用
+void setupThreads(int threads, AffinityMode mode);
+
+// 当前并行区域使用的线程数
+int threadCount();
+
+// 构造时不做值初始化的分配器，配合并行首次写入 (first-touch)
+// 让每页内存落在之后负责处理该段数据的线程所在的 NUMA 节点上
+template <typename T>
+class DefaultInitAllocator : public std::allocator<T>
+{
+public:
+    template <typename U>
+    struct rebind
+    {
+        using other = DefaultInitAllocator<U>;
+    };
+
+    DefaultInitAllocator() = default;
+    template <typename U>
+    DefaultInitAllocator(const DefaultInitAllocator<U> &) noexcept {}
+
+    template <typename U>
+    void construct(U *p) noexcept
+    {
+        ::new (static_cast<void *>(p)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U *p, Args &&...args)
+    {
+        ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+using NumaVector = std::vector<double, DefaultInitAllocator<double> >;
+using NumaIndexVector = std::vector<int, DefaultInitAllocator<int> >;
+
+// 按与求解循环相同的静态行划分并行复制，完成首次写入
+void firstTouchCopy(double *dst, const double *src, size_t n);
+void firstTouchFill(double *dst, double value, size_t n);
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+
+// 基于 Linux perf_event_open 的硬件计数器 (仅统计用户态)
+// 计数器在 OpenMP 线程池的每个线程上分别打开，读数为所有线程之和；
+// 非 Linux 平台、内核不支持或权限不足 (perf_event_paranoid) 时 available() 为 false
+class PerfCounters
+{
+public:
+    struct Counts
+    {
+        double cycles = 0.0;
+        double instructions = 0.0;
+        double llcReferences = 0.0;
+        double llcMisses = 0.0;
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    bool available() const { return available_; }
+
+    // 清零并开始计数
+    void start();
+    // 停止计数并返回 start 以来的读数 (已按多路复用时间比例缩放)
+    Counts stop();
+
+private:
+    // fds_[线程][事件]，打开失败的事件为 -1
+    std::vector<std::vector<int> > fds_;
+    bool available_ = false;
+};
@@ -0,0 +1,48 @@
+#pragma once
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "perf_counters.h"
+
+// 按阶段记录耗时、硬件计数器及字节数/浮点运算次数估计，并与机器 roofline 对比
+class Profiler
+{
+public:
+    // 机器上限：STREAM triad 带宽与 FMA 峰值
+    struct Roofline
+    {
+        double bandwidthGBs = 0.0;
+        double peakGFlops = 0.0;
+    };
+
+    struct Phase
+    {
+        std::string name;
+        double ms = 0.0;
+        PerfCounters::Counts counts;
+        double bytes = 0.0; // 估计访存字节数
+        double flops = 0.0; // 估计浮点运算次数
+    };
+
+    // 使用当前线程设置测量 roofline，耗时约数百毫秒
+    void measureRoofline();
+    const Roofline &getRoofline() const { return roofline_; }
+
+    // 开始一个阶段；end 时给出该阶段的工作量估计
+    void begin(const std::string &name);
+    void end(double bytes, double flops);
+
+    const std::vector<Phase> &getPhases() const { return phases_; }
+    bool countersAvailable() const { return counters_.available(); }
+
+    // 输出各阶段的 IPC、LLC 缺失、GB/s、GFLOP/s、算术强度及占 roofline 的比例
+    void report(std::ostream &out) const;
+
+private:
+    PerfCounters counters_;
+    Roofline roofline_;
+    std::vector<Phase> phases_;
+    std::string current_;
+    std::chrono::steady_clock::time_point start_;
+};
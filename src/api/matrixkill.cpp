@@ -0,0 +1,338 @@
+#include "../../include/matrixkill.h"
+#include "../../include/solvers/jacobi_solver.h"
+#include "../../include/solvers/gauss_solver.h"
+#include "../../include/solvers/sor_solver.h"
+#include "../../include/solvers/batched_solver.h"
+#include "../../include/operators/csr_operator.h"
+#include "../../include/operators/row_major_operator.h"
+#include "../../include/utils/timer.h"
+#include <cmath>
+#include <memory>
+#include <new>
+
+struct mk_solver
+{
+    mk_solver_type type;
+    std::unique_ptr<Solver> solver;
+    bool hasMatrix = false;
+};
+
+namespace
+{
+    // ||Ax - b||_2，x/b 为 n×k 行交错块中的第 c 列
+    double residualNorm(const LinearOperator &A, const double *x, const double *b,
+                        int k, int c)
+    {
+        const int n = A.size();
+        std::vector<double> xc(n);
+        std::vector<double> r(n);
+        for (int i = 0; i < n; ++i)
+            xc[i] = x[static_cast<size_t>(i) * k + c];
+        A.apply(xc.data(), r.data());
+
+        double sum = 0.0;
+        for (int i = 0; i < n; ++i)
+        {
+            double d = r[i] - b[static_cast<size_t>(i) * k + c];
+            sum += d * d;
+        }
+        return std::sqrt(sum);
+    }
+
+    // 写入 x/b 第 c 列的统计信息
+    void fillStats(mk_stats &stats, const LinearOperator &A, const double *x, const double *b,
+                   int k, int c, int iterations, bool converged, double setupMs, double solveMs)
+    {
+        stats.iterations = iterations;
+        stats.converged = converged ? 1 : 0;
+        stats.residual_norm = residualNorm(A, x, b, k, c);
+        stats.setup_ms = setupMs;
+        stats.solve_ms = solveMs;
+    }
+
+    // 直接法在首次求解前分解，单独计时并判断奇异
+    mk_status prepare(mk_solver *handle, double &setupMs)
+    {
+        setupMs = 0.0;
+        if (handle->type != MK_SOLVER_GAUSS)
+            return MK_OK;
+
+        auto *gauss = static_cast<GaussSolver *>(handle->solver.get());
+        if (gauss->isFactorized())
+            return MK_OK;
+
+        Timer timer;
+        bool ok = gauss->factorize();
+        setupMs = timer.getElapsedMilliseconds();
+        return ok ? MK_OK : MK_ERROR_SINGULAR;
+    }
+
+    template <typename Fn>
+    mk_status guarded(Fn fn)
+    {
+        try
+        {
+            return fn();
+        }
+        catch (...)
+        {
+            return MK_ERROR_INTERNAL;
+        }
+    }
+}
+
+extern "C"
+{
+    mk_solver *mk_solver_create(mk_solver_type type)
+    {
+        std::unique_ptr<mk_solver> handle(new (std::nothrow) mk_solver());
+        if (!handle)
+            return nullptr;
+
+        try
+        {
+            switch (type)
+            {
+            case MK_SOLVER_JACOBI:
+                handle->solver.reset(new JacobiSolver());
+                break;
+            case MK_SOLVER_GAUSS:
+                handle->solver.reset(new GaussSolver());
+                break;
+            case MK_SOLVER_SOR:
+                handle->solver.reset(new SORSolver());
+                break;
+            default:
+                return nullptr;
+            }
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+
+        handle->type = type;
+        handle->solver->setVerbose(false);
+        return handle.release();
+    }
+
+    void mk_solver_destroy(mk_solver *solver)
+    {
+        delete solver;
+    }
+
+    mk_status mk_solver_set_parameters(mk_solver *solver, double tolerance,
+                                       int max_iterations, double omega)
+    {
+        if (!solver || tolerance <= 0 || max_iterations <= 0)
+            return MK_ERROR_INVALID_ARGUMENT;
+
+        solver->solver->setParameters(tolerance, max_iterations);
+        if (omega > 0 && solver->type == MK_SOLVER_SOR)
+        {
+            static_cast<SORSolver *>(solver->solver.get())->setOmega(omega);
+        }
+        return MK_OK;
+    }
+
+    mk_status mk_solver_set_temporal_blocking(mk_solver *solver, int sweeps)
+    {
+        if (!solver)
+            return MK_ERROR_INVALID_ARGUMENT;
+
+        solver->solver->setTemporalBlocking(sweeps);
+        return MK_OK;
+    }
+
+    mk_status mk_solver_set_cache(mk_solver *solver, const char *directory,
+                                  unsigned long long max_bytes, int max_entries)
+    {
+        if (!solver || max_entries < 0)
+            return MK_ERROR_INVALID_ARGUMENT;
+        if (solver->type != MK_SOLVER_GAUSS)
+            return MK_OK;
+
+        return guarded([&]() {
+            std::shared_ptr<FactorCache> cache;
+            if (directory)
+                cache = std::make_shared<FactorCache>(directory, max_bytes, max_entries);
+            static_cast<GaussSolver *>(solver->solver.get())->setFactorCache(cache);
+            return MK_OK;
+        });
+    }
+
+    mk_status mk_solver_set_dense(mk_solver *solver, int n, const double *a, int lda)
+    {
+        if (!solver || n <= 0 || !a || lda < n)
+            return MK_ERROR_INVALID_ARGUMENT;
+
+        return guarded([&]() {
+            std::vector<double> zero(n, 0.0);
+            solver->solver->setOperator(std::make_shared<RowMajorOperator>(n, a, lda), zero);
+            solver->hasMatrix = true;
+            return MK_OK;
+        });
+    }
+
+    mk_status mk_solver_set_csr(mk_solver *solver, int n, const int *row_ptr,
+                                const int *col_idx, const double *values)
+    {
+        if (!solver || n <= 0 || !row_ptr || row_ptr[0] != 0 ||
+            (row_ptr[n] > 0 && (!col_idx || !values)))
+            return MK_ERROR_INVALID_ARGUMENT;
+
+        return guarded([&]() {
+            std::vector<double> zero(n, 0.0);
+            solver->solver->setOperator(
+                std::make_shared<CsrOperator>(n, row_ptr, col_idx, values), zero);
+            solver->hasMatrix = true;
+            return MK_OK;
+        });
+    }
+
+    mk_status mk_solver_solve(mk_solver *solver, const double *b, double *x, mk_stats *stats)
+    {
+        if (!solver || !b || !x)
+            return MK_ERROR_INVALID_ARGUMENT;
+        if (!solver->hasMatrix)
+            return MK_ERROR_NO_MATRIX;
+
+        return guarded([&]() {
+            Solver &s = *solver->solver;
+            const int n = s.getOperator().size();
+
+            double setupMs = 0.0;
+            mk_status status = prepare(solver, setupMs);
+            if (status != MK_OK)
+            {
+                if (stats)
+                    fillStats(*stats, s.getOperator(), x, b, 1, 0, 0, false, setupMs, 0.0);
+                return status;
+            }
+
+            s.setRightHandSide(b);
+            std::vector<double> xv(x, x + n);
+
+            Timer timer;
+            bool converged = s.solve(xv);
+            double solveMs = timer.getElapsedMilliseconds();
+            std::copy(xv.begin(), xv.end(), x);
+
+            if (stats)
+                fillStats(*stats, s.getOperator(), x, b, 1, 0, s.getIterations(), converged, setupMs, solveMs);
+            if (s.isSingular())
+                return MK_ERROR_SINGULAR;
+            return converged ? MK_OK : MK_ERROR_NOT_CONVERGED;
+        });
+    }
+
+    mk_status mk_solver_solve_block(mk_solver *solver, int k, const double *B,
+                                    double *X, mk_stats *stats)
+    {
+        if (!solver || k <= 0 || !B || !X)
+            return MK_ERROR_INVALID_ARGUMENT;
+        if (!solver->hasMatrix)
+            return MK_ERROR_NO_MATRIX;
+
+        return guarded([&]() {
+            Solver &s = *solver->solver;
+            const size_t total = static_cast<size_t>(s.getOperator().size()) * k;
+
+            double setupMs = 0.0;
+            mk_status status = prepare(solver, setupMs);
+            if (status != MK_OK)
+            {
+                if (stats)
+                    for (int c = 0; c < k; ++c)
+                        fillStats(stats[c], s.getOperator(), X, B, k, c, 0, false, setupMs, 0.0);
+                return status;
+            }
+
+            s.setRightHandSides(std::vector<double>(B, B + total), k);
+            std::vector<double> Xv(X, X + total);
+
+            Timer timer;
+            bool converged = s.solveBlock(Xv);
+            double solveMs = timer.getElapsedMilliseconds();
+            std::copy(Xv.begin(), Xv.end(), X);
+
+            if (stats)
+            {
+                const std::vector<int> &iterations = s.getColumnIterations();
+                const std::vector<char> &columnConverged = s.getColumnConverged();
+                for (int c = 0; c < k; ++c)
+                {
+                    fillStats(stats[c], s.getOperator(), X, B, k, c, iterations[c],
+                              columnConverged[c] != 0, setupMs, solveMs);
+                }
+            }
+            if (s.isSingular())
+                return MK_ERROR_SINGULAR;
+            return converged ? MK_OK : MK_ERROR_NOT_CONVERGED;
+        });
+    }
+
+    mk_status mk_solver_update_lowrank(mk_solver *solver, int k, const double *U, const double *V)
+    {
+        if (!solver || k <= 0 || !U || !V)
+            return MK_ERROR_INVALID_ARGUMENT;
+        if (!solver->hasMatrix)
+            return MK_ERROR_NO_MATRIX;
+
+        return guarded([&]() {
+            const size_t total = static_cast<size_t>(solver->solver->getOperator().size()) * k;
+            bool ok = solver->solver->updateLowRank(std::vector<double>(U, U + total),
+                                                    std::vector<double>(V, V + total), k);
+            return ok ? MK_OK : MK_ERROR_INVALID_ARGUMENT;
+        });
+    }
+
+    mk_status mk_solver_update_entries(mk_solver *solver, int count, const int *rows,
+                                       const int *cols, const double *values)
+    {
+        if (!solver || count < 0 || (count > 0 && (!rows || !cols || !values)))
+            return MK_ERROR_INVALID_ARGUMENT;
+        if (!solver->hasMatrix)
+            return MK_ERROR_NO_MATRIX;
+
+        return guarded([&]() {
+            bool ok = solver->solver->updateEntries(std::vector<int>(rows, rows + count),
+                                                    std::vector<int>(cols, cols + count),
+                                                    std::vector<double>(values, values + count));
+            return ok ? MK_OK : MK_ERROR_INVALID_ARGUMENT;
+        });
+    }
+
+    mk_status mk_solve_batched(int n, int count, const double *A, const double *b,
+                               double *x, unsigned char *status)
+    {
+        if (n < 1 || n > BatchedSolver::kMaxSize || count < 0 ||
+            (count > 0 && (!A || !b || !x)))
+            return MK_ERROR_INVALID_ARGUMENT;
+
+        return guarded([&]() {
+            int singular = BatchedSolver().solve(n, count, A, b, x, status);
+            return singular == 0 ? MK_OK : MK_ERROR_SINGULAR;
+        });
+    }
+
+    const char *mk_status_string(mk_status status)
+    {
+        switch (status)
+        {
+        case MK_OK:
+            return "成功";
+        case MK_ERROR_INVALID_ARGUMENT:
+            return "参数不合法";
+        case MK_ERROR_NO_MATRIX:
+            return "尚未设置系数矩阵";
+        case MK_ERROR_NOT_CONVERGED:
+            return "达到最大迭代次数仍未收敛";
+        case MK_ERROR_SINGULAR:
+            return "矩阵奇异或对角元为0";
+        case MK_ERROR_INTERNAL:
+            return "内部错误";
+        }
+        return "未知状态";
+    }
+}
@@ -1,52 +1,167 @@
 #include "../../include/core/config_reader.h"
+#include "../../include/core/matrix_parser.h"
+#include <cstring>
 #include <fstream>
-#include <sstream>
 #include <iostream>
 
+#if defined(__unix__) || defined(__APPLE__)
+#define MK_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // 只读映射整个文件，失败 (或平台不支持) 时返回 nullptr
+    std::shared_ptr<const char> mapFile(const std::string &filename, size_t &size)
+    {
+#ifdef MK_HAVE_MMAP
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+        struct stat st;
+        void *address = MAP_FAILED;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            size = static_cast<size_t>(st.st_size);
+            int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+            flags |= MAP_POPULATE; // 一次建立全部页表，避免解析时逐页缺页
+#endif
+            address = mmap(nullptr, size, PROT_READ, flags, fd, 0);
+        }
+        close(fd); // 映射不依赖文件描述符
+        if (address == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        return std::shared_ptr<const char>(static_cast<const char *>(address),
+                                           [size](const char *p) { munmap(const_cast<char *>(p), size); });
+#else
+        (void)filename;
+        (void)size;
+        return nullptr;
+#endif
+    }
+
+    // 读入堆上的缓冲区，不做清零
+    std::shared_ptr<const char> readFile(const std::string &filename, size_t &size)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            return nullptr;
+        }
+        file.seekg(0, std::ios::end);
+        size = static_cast<size_t>(file.tellg());
+        file.seekg(0, std::ios::beg);
+        std::shared_ptr<char> buffer(new char[size + 1], std::default_delete<char[]>());
+        file.read(buffer.get(), size);
+        if (static_cast<size_t>(file.gcount()) != size)
+        {
+            return nullptr;
+        }
+        return buffer;
+    }
+}
+
 bool ConfigReader::loadConfig(const std::string &filename)
 {
-    std::ifstream file(filename);
-    if (!file.is_open())
+    // 一次取得整个文件，键值只记录在其中的区间，大矩阵不产生副本
+    size_t size = 0;
+    std::shared_ptr<const char> text = mapFile(filename, size);
+    if (!text)
+    {
+        text = readFile(filename, size);
+    }
+    if (!text)
     {
         return false;
     }
+    text_ = text;
+    configMap_.clear();
 
-    std::string line;
+    const char *data = text_.get();
     std::string section;
+    size_t lineBegin = 0;
 
-    while (std::getline(file, line))
+    while (lineBegin < size)
     {
+        const void *newline = std::memchr(data + lineBegin, '\n', size - lineBegin);
+        size_t lineEnd = newline ? static_cast<const char *>(newline) - data : size;
+        size_t next = lineEnd + 1;
+
+        // 去除行尾的 '\r'
+        if (lineEnd > lineBegin && data[lineEnd - 1] == '\r')
+            --lineEnd;
+
         // 跳过空行和注释
-        if (line.empty() || line[0] == '#')
+        if (lineEnd == lineBegin || data[lineBegin] == '#')
+        {
+            lineBegin = next;
             continue;
+        }
 
         // 处理节名
-        if (line[0] == '[')
+        if (data[lineBegin] == '[')
         {
-            section = line.substr(1, line.find(']') - 1);
+            const void *close = std::memchr(data + lineBegin, ']', lineEnd - lineBegin);
+            size_t sectionEnd = close ? static_cast<const char *>(close) - data : lineEnd;
+            section.assign(data + lineBegin + 1, sectionEnd - lineBegin - 1);
+            lineBegin = next;
             continue;
         }
 
         // 处理键值对
-        auto pos = line.find('=');
-        if (pos != std::string::npos)
+        const void *eq = std::memchr(data + lineBegin, '=', lineEnd - lineBegin);
+        if (eq)
         {
-            std::string key = line.substr(0, pos);
-            std::string value = line.substr(pos + 1);
+            size_t pos = static_cast<const char *>(eq) - data;
 
             // 去除空白字符
-            key.erase(0, key.find_first_not_of(" \t"));
-            key.erase(key.find_last_not_of(" \t") + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t") + 1);
+            size_t keyBegin = lineBegin;
+            size_t keyEnd = pos;
+            while (keyBegin < keyEnd && (data[keyBegin] == ' ' || data[keyBegin] == '\t'))
+                ++keyBegin;
+            while (keyEnd > keyBegin && (data[keyEnd - 1] == ' ' || data[keyEnd - 1] == '\t'))
+                --keyEnd;
+            size_t valueBegin = pos + 1;
+            size_t valueEnd = lineEnd;
+            while (valueBegin < valueEnd && (data[valueBegin] == ' ' || data[valueBegin] == '\t'))
+                ++valueBegin;
+            while (valueEnd > valueBegin && (data[valueEnd - 1] == ' ' || data[valueEnd - 1] == '\t'))
+                --valueEnd;
 
-            configMap_[section + "." + key] = value;
+            std::string key = section + "." + std::string(data + keyBegin, keyEnd - keyBegin);
+            configMap_[key] = Span{valueBegin, valueEnd - valueBegin};
         }
+
+        lineBegin = next;
     }
 
     return true;
 }
 
+std::string ConfigReader::value(const std::string &key) const
+{
+    const Span &span = configMap_.at(key);
+    return std::string(text_.get() + span.offset, span.length);
+}
+
+bool ConfigReader::findValue(const std::string &key, const char *&begin, const char *&end) const
+{
+    auto it = configMap_.find(key);
+    if (it == configMap_.end())
+        return false;
+    begin = text_.get() + it->second.offset;
+    end = begin + it->second.length;
+    return true;
+}
+
 void ConfigReader::setSolverType(const std::string &type)
 {
     solverType_ = type;
@@ -83,64 +198,144 @@ void ConfigReader::setVectorB(const std::vector<double> &b)
     useDirectData_ = true;
 }
 
+void ConfigReader::setThreads(int threads)
+{
+    threads_ = threads;
+    useDirectData_ = true;
+}
+
+void ConfigReader::setAffinity(const std::string &affinity)
+{
+    affinity_ = affinity;
+    useDirectData_ = true;
+}
+
 std::string ConfigReader::getSolverType() const
 {
-    return useDirectData_ ? solverType_ : configMap_.at("Solver.type");
+    return useDirectData_ ? solverType_ : value("Solver.type");
 }
 
 double ConfigReader::getTolerance() const
 {
-    return useDirectData_ ? tolerance_ : std::stod(configMap_.at("Solver.tolerance"));
+    return useDirectData_ ? tolerance_ : std::stod(value("Solver.tolerance"));
 }
 
 int ConfigReader::getMaxIterations() const
 {
-    return useDirectData_ ? maxIterations_ : std::stoi(configMap_.at("Solver.max_iterations"));
+    return useDirectData_ ? maxIterations_ : std::stoi(value("Solver.max_iterations"));
 }
 
-int ConfigReader::getMatrixSize() const
+int ConfigReader::getTemporalSweeps() const
 {
-    return useDirectData_ ? size_ : std::stoi(configMap_.at("Matrix.size"));
+    return configMap_.count("Solver.temporal_sweeps") ? std::stoi(value("Solver.temporal_sweeps")) : 1;
 }
 
-std::vector<std::vector<double> > ConfigReader::getMatrixA() const
+int ConfigReader::getThreads() const
 {
     if (useDirectData_)
-        return A_;
+        return threads_;
+    return configMap_.count("Parallel.threads") ? std::stoi(value("Parallel.threads")) : 0;
+}
 
-    // 首先按分号分割每一行
-    std::vector<std::string> rows;
-    std::string matrixStr = configMap_.at("Matrix.A");
-    std::stringstream rowStream(matrixStr);
-    std::string rowStr;
+std::string ConfigReader::getAffinity() const
+{
+    if (useDirectData_)
+        return affinity_;
+    return configMap_.count("Parallel.affinity") ? value("Parallel.affinity") : "none";
+}
 
-    while (std::getline(rowStream, rowStr, ';'))
-    {
-        rows.push_back(rowStr);
-    }
+std::string ConfigReader::getCacheDirectory() const
+{
+    return configMap_.count("Cache.directory") ? value("Cache.directory") : "";
+}
 
-    int size = getMatrixSize();
-    std::vector<std::vector<double> > A(size, std::vector<double>(size));
+uint64_t ConfigReader::getCacheMaxBytes() const
+{
+    const double mb = configMap_.count("Cache.max_size_mb") ? std::stod(value("Cache.max_size_mb")) : 4096.0;
+    return static_cast<uint64_t>(mb * 1024.0 * 1024.0);
+}
 
-    // 添加调试信息
-    std::cout << "读取到的矩阵大小: " << size << std::endl;
-    std::cout << "读取到的矩阵行数: " << rows.size() << std::endl;
+int ConfigReader::getCacheMaxEntries() const
+{
+    return configMap_.count("Cache.max_entries") ? std::stoi(value("Cache.max_entries")) : 64;
+}
 
-    // 处理每一行
-    for (int i = 0; i < size; ++i)
-    {
-        // 按逗号分割每行的元素
-        std::vector<double> rowElements = parseNumberList(rows[i], ',');
+std::string ConfigReader::getOperatorType() const
+{
+    return configMap_.count("Matrix.operator") ? value("Matrix.operator") : "";
+}
+
+int ConfigReader::getGridSize() const
+{
+    return configMap_.count("Matrix.grid") ? std::stoi(value("Matrix.grid")) : 0;
+}
+
+std::string ConfigReader::getMatrixFormat() const
+{
+    return configMap_.count("Matrix.format") ? value("Matrix.format") : "csr";
+}
+
+int ConfigReader::getMatrixSize() const
+{
+    return useDirectData_ ? size_ : std::stoi(value("Matrix.size"));
+}
+
+bool ConfigReader::getSparseMatrixA(CsrMatrix &A) const
+{
+    const int size = getMatrixSize();
 
-        std::cout << "第 " << i + 1 << " 行元素: ";
-        for (int j = 0; j < size; ++j)
+    if (useDirectData_)
+    {
+        // 直接设置的稠密矩阵转为 CSR，丢弃零元素
+        A.n = size;
+        A.rowPtr.assign(1, 0);
+        A.colIdx.clear();
+        A.values.clear();
+        for (int i = 0; i < size; ++i)
         {
-            A[i][j] = rowElements[j];
-            std::cout << A[i][j] << " ";
+            for (int j = 0; j < size; ++j)
+            {
+                if (A_[i][j] != 0.0)
+                {
+                    A.colIdx.push_back(j);
+                    A.values.push_back(A_[i][j]);
+                }
+            }
+            A.rowPtr.push_back(A.colIdx.size());
         }
-        std::cout << std::endl;
+        return true;
     }
 
+    const char *begin;
+    const char *end;
+    if (!findValue("Matrix.A", begin, end))
+    {
+        std::cerr << "配置文件缺少系数矩阵 Matrix.A" << std::endl;
+        return false;
+    }
+
+    std::string error;
+    if (!parseCsrMatrix(begin, end, size, A, error))
+    {
+        std::cerr << "解析系数矩阵失败: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::vector<double> > ConfigReader::getMatrixA() const
+{
+    if (useDirectData_)
+        return A_;
+
+    CsrMatrix csr;
+    if (!getSparseMatrixA(csr))
+        return std::vector<std::vector<double> >();
+
+    std::vector<std::vector<double> > A(csr.n, std::vector<double>(csr.n, 0.0));
+    for (int i = 0; i < csr.n; ++i)
+        for (int k = csr.rowPtr[i]; k < csr.rowPtr[i + 1]; ++k)
+            A[i][csr.colIdx[k]] = csr.values[k];
     return A;
 }
 
@@ -148,33 +343,43 @@ std::vector<double> ConfigReader::getVectorB() const
 {
     if (useDirectData_)
         return b_;
-    return parseNumberList(configMap_.at("Matrix.b"), ',');
+    std::vector<std::vector<double> > rhs;
+    if (!getRightHandSides(rhs) || rhs.empty())
+        return std::vector<double>();
+    return rhs.front();
 }
 
-std::vector<double> ConfigReader::parseNumberList(const std::string &str, char delimiter) const
+bool ConfigReader::getRightHandSides(std::vector<std::vector<double> > &rhs) const
 {
-    std::vector<double> numbers;
-    std::stringstream ss(str);
-    std::string item;
+    rhs.clear();
+    if (useDirectData_)
+    {
+        rhs.push_back(b_);
+        return true;
+    }
+
+    const char *begin;
+    const char *end;
+    if (!findValue("Matrix.b", begin, end))
+        return true;
 
-    while (std::getline(ss, item, delimiter))
+    // 各右端项以分号分隔
+    while (begin < end)
     {
-        // 去除空白字符
-        item.erase(0, item.find_first_not_of(" \t\r\n"));
-        item.erase(item.find_last_not_of(" \t\r\n") + 1);
+        const void *sep = std::memchr(begin, ';', end - begin);
+        const char *stop = sep ? static_cast<const char *>(sep) : end;
 
-        if (!item.empty())
+        std::vector<double> b;
+        std::string error;
+        if (!parseNumberRow(begin, stop, b, error))
         {
-            try
-            {
-                numbers.push_back(std::stod(item));
-            }
-            catch (const std::exception &e)
-            {
-                std::cerr << "解析数字失败: " << item << " (" << e.what() << ")" << std::endl;
-            }
+            std::cerr << "错误: 第 " << rhs.size() + 1 << " 个右端项 " << error << std::endl;
+            rhs.clear();
+            return false;
         }
+        if (!b.empty())
+            rhs.push_back(b);
+        begin = sep ? stop + 1 : end;
     }
-
-    return numbers;
-}
\ No newline at end of file
+    return true;
+}
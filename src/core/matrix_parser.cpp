@@ -0,0 +1,626 @@
+#include "../../include/core/matrix_parser.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    // 空格及所有控制字符 (含 \t \r \n) 均视为空白
+    inline bool isSpace(char c)
+    {
+        return static_cast<unsigned char>(c) <= ' ';
+    }
+
+    inline const char *skipSpace(const char *p, const char *end)
+    {
+        while (p < end && isSpace(*p))
+            ++p;
+        return p;
+    }
+
+    inline bool isDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // 10^0 .. 10^22 均可被 double 精确表示
+    const double kPow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    // 不超过 15 位数字、不带指数的普通小数 (如 "-0.15")：尾数与 10 的幂都能精确表示，一次除法即正确舍入
+    // 不符合时返回 false，交给 parseNumber 的通用路径
+    inline bool parsePlainDecimal(const char *&p, const char *end, double &value)
+    {
+        const char *s = p;
+        const bool negative = s < end && *s == '-';
+        if (s < end && (*s == '-' || *s == '+'))
+            ++s;
+
+        uint64_t mantissa = 0;
+        unsigned digit;
+        const char *digits = s;
+        for (; s < end && (digit = static_cast<unsigned char>(*s) - '0') < 10; ++s)
+            mantissa = mantissa * 10 + digit;
+        int count = s - digits;
+        int fraction = 0;
+        if (s < end && *s == '.')
+        {
+            const char *first = ++s;
+            for (; s < end && (digit = static_cast<unsigned char>(*s) - '0') < 10; ++s)
+                mantissa = mantissa * 10 + digit;
+            fraction = s - first;
+            count += fraction;
+        }
+        if (count == 0 || count > 15 || (s < end && (*s == 'e' || *s == 'E')))
+            return false;
+
+        const double m = static_cast<double>(mantissa) / kPow10[fraction];
+        value = negative ? -m : m;
+        p = s;
+        return true;
+    }
+
+    inline bool parseNumber(const char *&p, const char *end, double &value)
+    {
+        const char *start = skipSpace(p, end);
+        if (parsePlainDecimal(start, end, value))
+        {
+            p = start;
+            return true;
+        }
+        const char *s = start;
+
+        bool negative = false;
+        if (s < end && (*s == '-' || *s == '+'))
+        {
+            negative = *s == '-';
+            ++s;
+        }
+
+        // 最多保留 19 位有效数字，超出则交给 strtod
+        uint64_t mantissa = 0;
+        int digits = 0;
+        int exponent = 0;
+        bool any = false;
+        bool truncated = false;
+
+        for (; s < end && isDigit(*s); ++s)
+        {
+            any = true;
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (*s - '0');
+                if (mantissa)
+                    ++digits;
+            }
+            else
+            {
+                ++exponent;
+                truncated = true;
+            }
+        }
+        if (s < end && *s == '.')
+        {
+            for (++s; s < end && isDigit(*s); ++s)
+            {
+                any = true;
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + (*s - '0');
+                    if (mantissa)
+                        ++digits;
+                    --exponent;
+                }
+                else
+                {
+                    truncated = true;
+                }
+            }
+        }
+        if (!any)
+            return false;
+
+        if (s < end && (*s == 'e' || *s == 'E'))
+        {
+            const char *e = s + 1;
+            bool expNegative = false;
+            if (e < end && (*e == '-' || *e == '+'))
+            {
+                expNegative = *e == '-';
+                ++e;
+            }
+            if (e < end && isDigit(*e))
+            {
+                int exp = 0;
+                for (; e < end && isDigit(*e); ++e)
+                {
+                    if (exp < 100000)
+                        exp = exp * 10 + (*e - '0');
+                }
+                exponent += expNegative ? -exp : exp;
+                s = e;
+            }
+        }
+
+        // 尾数不超过 2^53 且 |指数| <= 22 时，一次乘除即可得到正确舍入的结果
+        if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22)
+        {
+            double m = static_cast<double>(mantissa);
+            value = exponent < 0 ? m / kPow10[-exponent] : m * kPow10[exponent];
+            if (negative)
+                value = -value;
+            p = s;
+            return true;
+        }
+
+        // 其余情况复制到以 '\0' 结尾的临时缓冲区交给 strtod
+        const size_t length = s - start;
+        char local[64];
+        std::string heap;
+        const char *text = local;
+        if (length < sizeof(local))
+        {
+            std::memcpy(local, start, length);
+            local[length] = '\0';
+        }
+        else
+        {
+            heap.assign(start, length);
+            text = heap.c_str();
+        }
+        value = std::strtod(text, nullptr);
+        p = s;
+        return true;
+    }
+
+    // 逐字符解析 [begin, end) 中的一行，非零元素追加到 cols/vals，返回元素个数，格式错误返回 -1
+    int parseSparseRowSlow(const char *begin, const char *end, int n,
+                       NumaIndexVector &cols, NumaVector &vals)
+    {
+        const char *p = begin;
+        int col = 0;
+        for (;;)
+        {
+            p = skipSpace(p, end);
+            if (p == end)
+                break;
+            if (col >= n)
+                return -1;
+
+            // 稀疏矩阵中大部分元素是单独的 "0"，直接跳过
+            if (p[0] == '0' && (p + 1 == end || p[1] == ',' || isSpace(p[1])))
+            {
+                ++p;
+            }
+            else
+            {
+                double value;
+                if (!parseNumber(p, end, value))
+                    return -1;
+                if (value != 0.0)
+                {
+                    cols.push_back(col);
+                    vals.push_back(value);
+                }
+            }
+            ++col;
+
+            if (p < end && *p == ',')
+            {
+                ++p;
+                continue;
+            }
+            p = skipSpace(p, end);
+            if (p == end)
+                break;
+            if (*p != ',')
+                return -1;
+            ++p;
+        }
+        return col;
+    }
+
+    // 按 64 字节块扫描用到的位运算，字节按小端顺序装入 64 位字
+    bool isLittleEndian()
+    {
+        const uint16_t one = 1;
+        unsigned char first;
+        std::memcpy(&first, &one, 1);
+        return first == 1;
+    }
+
+    const bool kLittleEndian = isLittleEndian();
+
+    // 8 个字节中等于 c 的位置，结果的第 k 位对应第 k 个字节
+    inline uint64_t byteEquals(uint64_t word, unsigned char c)
+    {
+        const uint64_t low7 = 0x7f7f7f7f7f7f7f7fULL;
+        const uint64_t x = word ^ (0x0101010101010101ULL * c);
+        // 字节为 0 时最高位为 1，不会因进位误判相邻字节
+        const uint64_t high = ~(((x & low7) + low7) | x) & 0x8080808080808080ULL;
+        return (high >> 7) * 0x0102040810204080ULL >> 56;
+    }
+
+    // 64 字节中 ',' 与 '0' 的位图
+    inline void blockMasks(const char *p, uint64_t &commas, uint64_t &zeros)
+    {
+        commas = 0;
+        zeros = 0;
+        for (int k = 0; k < 8; ++k)
+        {
+            uint64_t word;
+            std::memcpy(&word, p + 8 * k, 8);
+            commas |= byteEquals(word, ',') << (8 * k);
+            zeros |= byteEquals(word, '0') << (8 * k);
+        }
+    }
+
+    inline int popCount(uint64_t x)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        int count = 0;
+        for (; x; x &= x - 1)
+            ++count;
+        return count;
+#endif
+    }
+
+    inline int lowestBit(uint64_t x)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(x);
+#else
+        int bit = 0;
+        for (; !(x & 1); x >>= 1)
+            ++bit;
+        return bit;
+#endif
+    }
+
+    // 元素文本 (不超过 8 字节) 到数值的直接映射缓存，每个线程一份
+    // 矩阵中同样的数值文本反复出现，文本逐字节相同才命中，结果与解析一致
+    class ValueCache
+    {
+    public:
+        ValueCache() : slots_(1 << kBits) {}
+
+        // text 为按小端装入的元素文本，超出 length 的字节须为 0
+        bool find(uint64_t text, int length, double &value) const
+        {
+            const Slot &slot = slots_[index(text)];
+            if (slot.length != length || slot.text != text)
+                return false;
+            value = slot.value;
+            return true;
+        }
+
+        void insert(uint64_t text, int length, double value)
+        {
+            Slot &slot = slots_[index(text)];
+            slot.text = text;
+            slot.length = length;
+            slot.value = value;
+        }
+
+    private:
+        static const int kBits = 10;
+        struct Slot
+        {
+            uint64_t text = 0;
+            int length = 0; // 0 表示空槽
+            double value = 0.0;
+        };
+        std::vector<Slot> slots_;
+
+        static size_t index(uint64_t text)
+        {
+            return (text * 0x9e3779b97f4a7c15ULL) >> (64 - kBits);
+        }
+    };
+
+    // 行扫描的状态：col 为块起点之前的逗号数，prevComma 表示块前一字节为逗号 (行首也视为逗号)
+    struct RowScan
+    {
+        int col = 0;
+        uint64_t prevComma = 1;
+    };
+
+    // 处理一个 64 字节块：valid 为有效字节的位图 (无效字节中的逗号只用于判断其前一字节)，
+    // nextComma 表示块后的字节为逗号，[p, readable) 可以安全读取
+    // 单独的 "0" 由位图直接跳过；其余元素若在块内以逗号结束且不超过 8 字节先查缓存，
+    // 否则从原位置解析 (可越过块尾，直到 end)。出现空元素或元素后不是逗号时返回 false
+    inline bool scanBlock(const char *p, const char *end, const char *readable, uint64_t valid, bool nextComma,
+                          RowScan &scan, ValueCache &cache, NumaIndexVector &cols, NumaVector &vals)
+    {
+        uint64_t commas;
+        uint64_t zeros;
+        blockMasks(p, commas, zeros);
+        const uint64_t before = (commas >> 1) | (static_cast<uint64_t>(nextComma) << 63);
+        const uint64_t separators = commas;
+        commas &= valid;
+        const uint64_t after = (commas << 1) | scan.prevComma;
+        if (after & commas)
+            return false;
+
+        uint64_t starts = after & valid & ~(zeros & before);
+        while (starts)
+        {
+            const int bit = lowestBit(starts);
+            starts &= starts - 1;
+
+            const char *q = p + bit;
+            const uint64_t rest = separators >> bit;
+            const int length = rest ? lowestBit(rest) : 64;
+            const bool cacheable = length <= 8 && readable - q >= 8;
+            uint64_t text = 0;
+            double value;
+            bool hit = false;
+            if (cacheable)
+            {
+                std::memcpy(&text, q, 8);
+                if (length < 8)
+                    text &= (static_cast<uint64_t>(1) << (8 * length)) - 1;
+                hit = cache.find(text, length, value);
+            }
+            if (!hit)
+            {
+                if (!parsePlainDecimal(q, end, value) && !parseNumber(q, end, value))
+                    return false;
+                if (q != end && *q != ',')
+                {
+                    q = skipSpace(q, end);
+                    if (q != end && *q != ',')
+                        return false;
+                }
+                if (cacheable)
+                    cache.insert(text, length, value);
+            }
+            if (value != 0.0)
+            {
+                cols.push_back(scan.col + popCount(commas & ((static_cast<uint64_t>(1) << bit) - 1)));
+                vals.push_back(value);
+            }
+        }
+
+        scan.col += popCount(commas);
+        scan.prevComma = commas >> 63;
+        return true;
+    }
+
+    // 解析 [begin, end) 中的一行，非零元素追加到 cols/vals，返回元素个数，格式错误返回 -1
+    // 先按 64 字节块用位运算找出逗号与单独的 "0"，只逐个解析其余元素，避免按元素分支；
+    // 空白、空元素等少见写法交给逐字符解析，两条路径结果一致
+    int parseSparseRow(const char *begin, const char *end, int n, ValueCache &cache,
+                       NumaIndexVector &cols, NumaVector &vals)
+    {
+        if (!kLittleEndian)
+            return parseSparseRowSlow(begin, end, n, cols, vals);
+
+        const size_t mark = cols.size();
+        RowScan scan;
+        const char *p = begin;
+        bool ok = true;
+        for (; ok && end - p > 64; p += 64)
+        {
+            ok = scanBlock(p, end, end, ~static_cast<uint64_t>(0), p[64] == ',', scan, cache, cols, vals);
+        }
+
+        // 不足 64 字节的尾部复制到补齐的缓冲区，行尾之后放一个逗号作为结束
+        if (ok)
+        {
+            const int length = end - p;
+            char tail[72];
+            std::memcpy(tail, p, length);
+            std::memset(tail + length, ' ', sizeof(tail) - length);
+            tail[length] = ',';
+            const uint64_t valid = length == 64 ? ~static_cast<uint64_t>(0)
+                                                : (static_cast<uint64_t>(1) << length) - 1;
+            ok = scanBlock(tail, tail + length + 1, tail + sizeof(tail), valid, true, scan, cache, cols, vals);
+        }
+
+        // 行末不是逗号时最后一个元素之后没有逗号
+        const char *last = end;
+        while (last > begin && isSpace(last[-1]))
+            --last;
+        const int count = scan.col + (last > begin && last[-1] != ',' ? 1 : 0);
+        if (ok && count <= n)
+            return count;
+
+        cols.resize(mark);
+        vals.resize(mark);
+        return parseSparseRowSlow(begin, end, n, cols, vals);
+    }
+}
+
+bool parseDouble(const char *&p, const char *end, double &value)
+{
+    return parseNumber(p, end, value);
+}
+
+bool parseNumberRow(const char *begin, const char *end,
+                    std::vector<double> &out, std::string &error)
+{
+    const char *p = skipSpace(begin, end);
+    while (p < end)
+    {
+        if (*p == ',')
+        {
+            p = skipSpace(p + 1, end);
+            continue;
+        }
+
+        double value;
+        if (!parseDouble(p, end, value))
+        {
+            const char *stop = p;
+            while (stop < end && *stop != ',')
+                ++stop;
+            error = "解析数字失败: " + std::string(p, stop);
+            return false;
+        }
+        out.push_back(value);
+
+        p = skipSpace(p, end);
+        if (p < end && *p != ',')
+        {
+            error = "数字之间缺少逗号: " + std::string(p, std::min<size_t>(end - p, 16));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseCsrMatrix(const char *begin, const char *end, int n,
+                    CsrMatrix &out, std::string &error)
+{
+    const size_t length = end - begin;
+
+    // 第一步：按字节区间分块并行查找 ';'
+    std::vector<std::vector<const char *> > separators(threadCount());
+#pragma omp parallel
+    {
+        int tid = 0;
+        int nthreads = 1;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+        nthreads = omp_get_num_threads();
+#endif
+        const char *chunkBegin = begin + length * tid / nthreads;
+        const char *chunkEnd = begin + length * (tid + 1) / nthreads;
+        std::vector<const char *> &local = separators[tid];
+        for (const char *p = chunkBegin; p < chunkEnd;)
+        {
+            const void *hit = std::memchr(p, ';', chunkEnd - p);
+            if (!hit)
+                break;
+            local.push_back(static_cast<const char *>(hit));
+            p = static_cast<const char *>(hit) + 1;
+        }
+    }
+
+    // 合并为行区间，跳过只含空白的空行 (例如末尾多余的 ';')
+    std::vector<const char *> rowBegin;
+    std::vector<const char *> rowEnd;
+    rowBegin.reserve(n);
+    rowEnd.reserve(n);
+    const char *segment = begin;
+    auto addRow = [&](const char *stop) {
+        if (skipSpace(segment, stop) != stop)
+        {
+            rowBegin.push_back(segment);
+            rowEnd.push_back(stop);
+        }
+        segment = stop + 1;
+    };
+    for (const auto &local : separators)
+        for (const char *sep : local)
+            addRow(sep);
+    addRow(end);
+
+    if (static_cast<int>(rowBegin.size()) != n)
+    {
+        error = "矩阵行数 " + std::to_string(rowBegin.size()) + " 与矩阵大小 " +
+                std::to_string(n) + " 不符";
+        return false;
+    }
+
+    // 均匀抽取若干行估计非零元个数，线程局部缓冲区按估计值一次预留，避免解析中反复扩容
+    size_t estimate = 0;
+    {
+        const int samples = std::min(n, 16);
+        ValueCache cache;
+        NumaIndexVector cols;
+        NumaVector vals;
+        for (int k = 0; k < samples; ++k)
+        {
+            const int i = static_cast<int>(static_cast<int64_t>(n) * k / samples);
+            parseSparseRow(rowBegin[i], rowEnd[i], n, cache, cols, vals);
+        }
+        if (samples > 0)
+            estimate = cols.size() * static_cast<size_t>(n) / samples;
+    }
+
+    // 第二步：按行并行解析到线程局部缓冲区，再按相同的静态划分写入最终数组
+    out.n = n;
+    out.rowPtr.resize(n + 1);
+    std::vector<int> localOffset(n);
+    int badRow = -1;
+
+#pragma omp parallel
+    {
+        int nthreads = 1;
+#ifdef _OPENMP
+        nthreads = omp_get_num_threads();
+#endif
+        ValueCache cache;
+        NumaIndexVector cols;
+        NumaVector vals;
+        const size_t reserve = estimate / nthreads + estimate / nthreads / 16 + n;
+        cols.reserve(reserve);
+        vals.reserve(reserve);
+
+#pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            localOffset[i] = cols.size();
+            int count = parseSparseRow(rowBegin[i], rowEnd[i], n, cache, cols, vals);
+            if (count != n)
+            {
+#pragma omp critical
+                if (badRow < 0 || i < badRow)
+                    badRow = i;
+            }
+            out.rowPtr[i + 1] = cols.size() - localOffset[i];
+        }
+
+#pragma omp single
+        {
+            out.rowPtr[0] = 0;
+            if (badRow < 0)
+            {
+                for (int i = 0; i < n; ++i)
+                    out.rowPtr[i + 1] += out.rowPtr[i];
+                // 单线程时局部缓冲区已是按行顺序排列的最终数组，直接接管
+                if (nthreads == 1)
+                {
+                    out.colIdx.swap(cols);
+                    out.values.swap(vals);
+                }
+                else
+                {
+                    out.colIdx.resize(out.rowPtr[n]);
+                    out.values.resize(out.rowPtr[n]);
+                }
+            }
+        }
+
+        // 同一并行区域内相同的静态划分保证每行仍由解析它的线程处理
+        if (badRow < 0 && nthreads > 1)
+        {
+#pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                const int count = out.rowPtr[i + 1] - out.rowPtr[i];
+                std::copy(cols.begin() + localOffset[i], cols.begin() + localOffset[i] + count,
+                          out.colIdx.begin() + out.rowPtr[i]);
+                std::copy(vals.begin() + localOffset[i], vals.begin() + localOffset[i] + count,
+                          out.values.begin() + out.rowPtr[i]);
+            }
+        }
+    }
+
+    if (badRow >= 0)
+    {
+        error = "第 " + std::to_string(badRow + 1) + " 行格式错误或元素个数不是 " + std::to_string(n);
+        return false;
+    }
+    return true;
+}
@@ -1,12 +1,379 @@
 #include "../../include/core/solver.h"
+#include "../../include/operators/updated_operator.h"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
+namespace
+{
+    // 时间分块按每线程约 1 MiB 的缓存规划行块 (常见的 L2 大小)
+    const double kTemporalCacheBytes = 1024.0 * 1024.0;
+}
+
 void Solver::setEquation(const std::vector<std::vector<double> > &A,
                          const std::vector<double> &b)
 {
-    A_ = A;
-    b_ = b;
+    const int n = A.size();
+    A_.clear();
+    A_.resize(n);
+    b_.resize(b.size());
+
+    // 每行由之后在求解循环中处理它的线程分配并写入，使数据位于该线程所在的 NUMA 节点
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        A_[i].assign(A[i].begin(), A[i].end());
+    }
+    firstTouchCopy(b_.data(), b.data(), b.size());
+    op_ = std::make_shared<DenseOperator>(A_);
+    updated_.reset();
+    lastSolution_.clear();
+    invalidate();
+}
+
+void Solver::setOperator(std::shared_ptr<const LinearOperator> op,
+                         const std::vector<double> &b)
+{
+    A_.clear();
+    op_ = op;
+    updated_.reset();
+    lastSolution_.clear();
+    b_.resize(b.size());
+    firstTouchCopy(b_.data(), b.data(), b.size());
+    invalidate();
+}
+
+bool Solver::updateLowRank(const std::vector<double> &U, const std::vector<double> &V, int k)
+{
+    if (!op_)
+    {
+        std::cerr << "错误：尚未设置系数矩阵" << std::endl;
+        return false;
+    }
+    const int n = op_->size();
+    const size_t expected = static_cast<size_t>(n) * k;
+    if (k <= 0 || U.size() != expected || V.size() != expected)
+    {
+        std::cerr << "错误：低秩更新的维度不匹配" << std::endl;
+        return false;
+    }
+
+    if (A_.empty())
+    {
+        // 其余算子在其上叠加低秩因子，不展开为稠密行
+        updatedOperator().addLowRank(U.data(), V.data(), k);
+        lowRankUpdate(U, V, k);
+        warmStart_ = true;
+        return true;
+    }
+
+    // 显式稠密矩阵原地修改：只有 U 的非零行对应的 A 行发生变化，delta = U[i,:] Vᵀ
+    std::vector<double> delta(n);
+    for (int i = 0; i < n; ++i)
+    {
+        const double *u = &U[static_cast<size_t>(i) * k];
+        bool changed = false;
+        for (int c = 0; c < k && !changed; ++c)
+        {
+            changed = u[c] != 0.0;
+        }
+        if (!changed)
+        {
+            continue;
+        }
+
+        for (int j = 0; j < n; ++j)
+        {
+            const double *v = &V[static_cast<size_t>(j) * k];
+            double sum = 0.0;
+            for (int c = 0; c < k; ++c)
+            {
+                sum += u[c] * v[c];
+            }
+            delta[j] = sum;
+        }
+        for (int j = 0; j < n; ++j)
+        {
+            A_[i][j] += delta[j];
+        }
+    }
+
+    lowRankUpdate(U, V, k);
+    warmStart_ = true;
+    return true;
+}
+
+bool Solver::updateEntries(const std::vector<int> &rows, const std::vector<int> &cols,
+                           const std::vector<double> &values)
+{
+    if (!op_)
+    {
+        std::cerr << "错误：尚未设置系数矩阵" << std::endl;
+        return false;
+    }
+    const int n = op_->size();
+    if (rows.size() != cols.size() || rows.size() != values.size())
+    {
+        std::cerr << "错误：稀疏更新的行号、列号与数值个数不一致" << std::endl;
+        return false;
+    }
+
+    for (size_t t = 0; t < rows.size(); ++t)
+    {
+        if (rows[t] < 0 || rows[t] >= n || cols[t] < 0 || cols[t] >= n)
+        {
+            std::cerr << "错误：稀疏更新的下标 (" << rows[t] << ", " << cols[t] << ") 越界" << std::endl;
+            return false;
+        }
+    }
+    if (rows.empty())
+    {
+        return true;
+    }
+
+    // 按元素记录增量，不展开为低秩因子
+    for (size_t t = 0; t < rows.size(); ++t)
+    {
+        if (!A_.empty())
+            A_[rows[t]][cols[t]] += values[t];
+        else
+            updatedOperator().addEntry(rows[t], cols[t], values[t]);
+    }
+    entriesUpdate(rows, cols, values);
+    warmStart_ = true;
+    return true;
+}
+
+UpdatedOperator &Solver::updatedOperator()
+{
+    if (!updated_ || op_ != updated_)
+    {
+        updated_ = std::make_shared<UpdatedOperator>(op_);
+        op_ = updated_;
+    }
+    return *updated_;
+}
+
+void Solver::lowRankUpdate(const std::vector<double> &, const std::vector<double> &, int)
+{
+    invalidate();
+}
+
+void Solver::entriesUpdate(const std::vector<int> &, const std::vector<int> &, const std::vector<double> &)
+{
+    invalidate();
+}
+
+void Solver::initialGuess(std::vector<double> &x, int n)
+{
+    if (warmStart_ && static_cast<int>(lastSolution_.size()) == n)
+    {
+        x = lastSolution_;
+    }
+    else
+    {
+        x.resize(n, 0.0);
+    }
+    warmStart_ = false;
+}
+
+void Solver::rememberSolution(const std::vector<double> &x)
+{
+    lastSolution_ = x;
+}
+
+void Solver::setRightHandSide(const double *b)
+{
+    const size_t n = op_->size();
+    b_.resize(n);
+    firstTouchCopy(b_.data(), b, n);
+}
+
+bool Solver::loadDiagonal(NumaVector &diag)
+{
+    const int n = op_->size();
+    diag.resize(n);
+    bool singular = false;
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        diag[i] = op_->diagonal(i);
+        if (std::abs(diag[i]) < 1e-10)
+        {
+#pragma omp critical
+            singular = true;
+        }
+    }
+    singular_ = singular;
+    return !singular;
+}
+
+void Solver::setRightHandSides(const std::vector<double> &B, int k)
+{
+    rhsCount_ = k;
+    B_.resize(B.size());
+    firstTouchCopy(B_.data(), B.data(), B.size());
+}
+
+bool Solver::solveBlock(std::vector<double> &X)
+{
+    const int n = op_->size();
+    const int k = rhsCount_;
+    X.resize(static_cast<size_t>(n) * k, 0.0);
+    columnIterations_.assign(k, 0);
+    columnConverged_.assign(k, 0);
+
+    NumaVector savedB = b_;
+    std::vector<double> x(n);
+    bool success = true;
+    bool singular = false;
+    WorkEstimate total;
+
+    for (int c = 0; c < k; ++c)
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            b_[i] = B_[static_cast<size_t>(i) * k + c];
+            x[i] = X[static_cast<size_t>(i) * k + c];
+        }
+        const bool converged = solve(x);
+        singular = singular || singular_;
+        columnConverged_[c] = converged;
+        success = converged && success;
+        total.bytes += work_.bytes;
+        total.flops += work_.flops;
+        for (int i = 0; i < n; ++i)
+        {
+            X[static_cast<size_t>(i) * k + c] = x[i];
+        }
+    }
+
+    b_.swap(savedB);
+    work_ = total;
+    singular_ = singular;
+    return success;
+}
+
+void Solver::dropColumns(NumaVector &block, int n, int width, const std::vector<char> &keep)
+{
+    std::vector<int> cols;
+    for (int c = 0; c < width; ++c)
+        if (keep[c])
+            cols.push_back(c);
+    const int kept = cols.size();
+
+    // 压缩后的块同样按行划分首次写入
+    NumaVector packed(static_cast<size_t>(n) * kept);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        for (int q = 0; q < kept; ++q)
+            packed[static_cast<size_t>(i) * kept + q] = block[static_cast<size_t>(i) * width + cols[q]];
+    }
+    block.swap(packed);
+}
+
+void Solver::storeColumns(std::vector<double> &X, const std::vector<int> &cols,
+                          const NumaVector &W, int n) const
+{
+    const int width = cols.size();
+    for (int i = 0; i < n; ++i)
+    {
+        for (int q = 0; q < width; ++q)
+            X[static_cast<size_t>(i) * rhsCount_ + cols[q]] = W[static_cast<size_t>(i) * width + q];
+    }
+}
+
+int Solver::retireColumns(std::vector<double> &X, std::vector<int> &cols,
+                          const std::vector<double> &diff, int iter,
+                          NumaVector &W, NumaVector &Bw, int n)
+{
+    const int width = cols.size();
+    std::vector<char> keep(width, 1);
+    std::vector<int> done;
+    std::vector<int> remaining;
+
+    for (int q = 0; q < width; ++q)
+    {
+        if (diff[q] < tolerance_)
+        {
+            keep[q] = 0;
+            done.push_back(q);
+            columnIterations_[cols[q]] = iter + 1;
+            columnConverged_[cols[q]] = 1;
+        }
+        else
+        {
+            remaining.push_back(cols[q]);
+        }
+    }
+
+    if (done.empty())
+        return width;
+
+    for (int i = 0; i < n; ++i)
+    {
+        for (int q : done)
+            X[static_cast<size_t>(i) * rhsCount_ + cols[q]] = W[static_cast<size_t>(i) * width + q];
+    }
+
+    dropColumns(W, n, width, keep);
+    dropColumns(Bw, n, width, keep);
+    cols.swap(remaining);
+    return cols.size();
+}
+
+void Solver::addSweepWork(int m, int vectors, double flopsPerRow)
+{
+    const double n = op_->size();
+    work_.bytes += op_->matrixBytes() + 8.0 * n * m * vectors;
+    work_.flops += m * (op_->applyFlops() + flopsPerRow * n);
+}
+
+void Solver::addTemporalWork(int levels, int vectors, double flopsPerRow)
+{
+    const double n = op_->size();
+    work_.bytes += op_->matrixBytes() + 8.0 * n * vectors;
+    work_.flops += levels * (op_->applyFlops() + flopsPerRow * n);
+}
+
+int Solver::temporalTileRows(int bandwidth, int levels, int vectors, int threads) const
+{
+    if (bandwidth < 0 || levels <= 1)
+    {
+        return 0;
+    }
+    const int n = op_->size();
+    const double rowBytes = op_->matrixBytes() / std::max(1, n) + 8.0 * vectors;
+    const double cacheRows = kTemporalCacheBytes * std::max(1, threads) / rowBytes;
+    const double skew = static_cast<double>(levels - 1) * bandwidth;
+    const double tile = cacheRows - skew;
+    if (tile < std::max(skew, 1.0))
+    {
+        return 0;
+    }
+    return static_cast<int>(std::min<double>(tile, n));
+}
+
+void Solver::wavefront(int n, int bandwidth, int levels, int tile,
+                       const std::function<void(int, int, int)> &sweep)
+{
+    // 最后几块只剩被错位推出的高层行
+    const long long skew = static_cast<long long>(levels - 1) * bandwidth;
+    for (long long lo = 0; lo - skew < n; lo += tile)
+    {
+        for (int t = 0; t < levels; ++t)
+        {
+            const long long shift = static_cast<long long>(t) * bandwidth;
+            const int begin = static_cast<int>(std::max(0LL, lo - shift));
+            const int end = static_cast<int>(std::min<long long>(n, lo + tile - shift));
+            if (begin < end)
+            {
+                sweep(t, begin, end);
+            }
+        }
+    }
 }
 
 void Solver::setParameters(double tolerance, int maxIterations)
@@ -39,13 +406,11 @@ bool Solver::checkSolvability() const
 
 bool Solver::checkDimensions() const
 {
-    if (A_.empty() || A_[0].empty() || b_.empty())
-        return false;
-
-    const size_t n = A_.size();
-    if (b_.size() != n)
+    if (!op_ || op_->size() <= 0 || b_.size() != static_cast<size_t>(op_->size()))
         return false;
 
+    // 显式矩阵还需检查每行长度
+    const size_t n = op_->size();
     for (const auto &row : A_)
         if (row.size() != n)
             return false;
@@ -55,35 +420,33 @@ bool Solver::checkDimensions() const
 
 bool Solver::checkZeroMatrix() const
 {
-    for (const auto &row : A_)
-        for (double val : row)
-            if (std::abs(val) > tolerance_)
-                return false;
+    const int n = op_->size();
+    for (int i = 0; i < n; ++i)
+        if (std::abs(op_->diagonal(i)) > tolerance_ || op_->offDiagonalAbsSum(i) > tolerance_)
+            return false;
     return true;
 }
 
 bool Solver::checkDiagonalDominance() const
 {
-    const size_t n = A_.size();
-    for (size_t i = 0; i < n; ++i)
+    const int n = op_->size();
+    for (int i = 0; i < n; ++i)
     {
-        double diagonal = std::abs(A_[i][i]);
-        double sum = 0.0;
-        for (size_t j = 0; j < n; ++j)
+        double diagonal = std::abs(op_->diagonal(i));
+        double sum = op_->offDiagonalAbsSum(i);
+
+        if (verbose_)
         {
-            if (j != i)
-                sum += std::abs(A_[i][j]);
+            std::cout << "行 " << i + 1 << " 的对角元素: " << diagonal
+                      << ", 其他元素之和: " << sum << std::endl;
         }
 
-        std::cout << "行 " << i + 1 << " 的对角元素: " << diagonal
-                  << ", 其他元素之和: " << sum << std::endl;
-
         if (diagonal < sum)
         {
-            std::cout << "第 " << i + 1 << " 行不满足对角占优: |" << A_[i][i]
+            std::cout << "第 " << i + 1 << " 行不满足对角占优: |" << op_->diagonal(i)
                       << "| < " << sum << std::endl;
             return false;
         }
     }
     return true;
-}
\ No newline at end of file
+}
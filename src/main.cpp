@@ -2,22 +2,74 @@
 #include <memory>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
 #include "../include/core/solver.h"
 #include "../include/solvers/jacobi_solver.h"
 #include "../include/solvers/gauss_solver.h"
 #include "../include/core/config_reader.h"
 #include "../include/utils/timer.h"
+#include "../include/utils/parallel.h"
+#include "../include/utils/profiler.h"
 #include "../include/solvers/sor_solver.h"
+#include "../include/operators/poisson_operator.h"
+#include "../include/operators/csr_operator.h"
+#include "../include/operators/format_selector.h"
+
+// 写入一组 b、x 及其残差
+void writeSolution(std::ofstream &file,
+                   const LinearOperator &A,
+                   const std::vector<double> &b,
+                   const std::vector<double> &x)
+{
+    // 写入向量b
+    file << "\n常数向量 b:\n";
+    for (double val : b)
+    {
+        file << std::setw(12) << val;
+    }
+    file << "\n";
+
+    // 写入解向量x
+    file << "\n解向量 x:\n";
+    for (double val : x)
+    {
+        file << std::setw(12) << val;
+    }
+    file << "\n";
+
+    // 计算并写入残差
+    file << "\n残差向量 (Ax-b):\n";
+    std::vector<double> residual(b.size());
+    A.apply(x.data(), residual.data());
+    for (size_t i = 0; i < residual.size(); ++i)
+    {
+        residual[i] -= b[i];
+        file << std::setw(12) << residual[i];
+    }
+    file << "\n";
+
+    // 计算残差范数
+    double residualNorm = 0.0;
+    for (double val : residual)
+    {
+        residualNorm += val * val;
+    }
+    residualNorm = std::sqrt(residualNorm);
+    file << "\n残差范数: " << residualNorm << "\n";
+}
 
 void saveResults(const std::string &filename,
-                 const std::vector<std::vector<double> > &A,
-                 const std::vector<double> &b,
-                 const std::vector<double> &x,
+                 const LinearOperator &op,
+                 bool matrixFree,
+                 const std::vector<std::vector<double> > &bs,
+                 const std::vector<std::vector<double> > &xs,
                  const std::string &solverType,
                  double tolerance,
                  int maxIterations,
-                 int actualIterations,
-                 double timeMs)
+                 const std::vector<int> &actualIterations,
+                 double timeMs,
+                 const Profiler *profiler)
 {
     std::ofstream file(filename);
     if (!file.is_open())
@@ -31,62 +83,57 @@ void saveResults(const std::string &filename,
 
     // 写入求解信息
     file << "求解方法: " << solverType << "\n";
-    file << "矩阵规模: " << A.size() << "\n";
+    file << "矩阵规模: " << op.size() << "\n";
     file << "收敛精度: " << tolerance << "\n";
     file << "最大迭代次数: " << maxIterations << "\n";
-    file << "实际迭代次数: " << actualIterations << "\n";
+    if (bs.size() == 1)
+    {
+        file << "实际迭代次数: " << actualIterations[0] << "\n";
+    }
+    else
+    {
+        file << "右端项个数: " << bs.size() << "\n";
+    }
     file << "计算时间: " << timeMs << "ms\n\n";
 
-    // 写入矩阵A
-    file << "系数矩阵 A:\n";
-    for (const auto &row : A)
+    // 写入矩阵A (矩阵自由算子只写名称)
+    if (matrixFree)
     {
-        for (double val : row)
-        {
-            file << std::setw(12) << val;
-        }
-        file << "\n";
+        file << "系数矩阵 A: " << op.name() << " 算子 (矩阵自由)\n";
     }
-
-    // 写入向量b
-    file << "\n常数向量 b:\n";
-    for (double val : b)
+    else
     {
-        file << std::setw(12) << val;
+        file << "系数矩阵 A:\n";
+        std::vector<double> row(op.size());
+        for (int i = 0; i < op.size(); ++i)
+        {
+            op.copyRow(i, row.data());
+            for (double val : row)
+            {
+                file << std::setw(12) << val;
+            }
+            file << "\n";
+        }
     }
-    file << "\n";
 
-    // 写入解向量x
-    file << "\n解向量 x:\n";
-    for (double val : x)
+    if (bs.size() == 1)
     {
-        file << std::setw(12) << val;
+        writeSolution(file, op, bs[0], xs[0]);
     }
-    file << "\n";
-
-    // 计算并写入残差
-    file << "\n残差向量 (Ax-b):\n";
-    std::vector<double> residual(b.size());
-    for (size_t i = 0; i < A.size(); ++i)
+    else
     {
-        double sum = 0.0;
-        for (size_t j = 0; j < A[i].size(); ++j)
+        for (size_t c = 0; c < bs.size(); ++c)
         {
-            sum += A[i][j] * x[j];
+            file << "\n===== 右端项 " << c + 1 << " =====\n";
+            file << "实际迭代次数: " << actualIterations[c] << "\n";
+            writeSolution(file, op, bs[c], xs[c]);
         }
-        residual[i] = sum - b[i];
-        file << std::setw(12) << residual[i];
     }
-    file << "\n";
 
-    // 计算残差范数
-    double residualNorm = 0.0;
-    for (double val : residual)
+    if (profiler)
     {
-        residualNorm += val * val;
+        profiler->report(file);
     }
-    residualNorm = std::sqrt(residualNorm);
-    file << "\n残差范数: " << residualNorm << "\n";
 
     file.close();
 }
@@ -104,12 +151,26 @@ void printUsage(const char *programName)
               << "  -t, --tolerance <精度>     设置求解精度 (默认: 使用配置文件中的设置)\n"
               << "  -m, --max-iter <次数>      设置最大迭代次数 (默认: 使用配置文件中的设置)\n"
               << "  -w, --omega <系数>         设置SOR松弛因子 (默认: 1.5, 仅用于SOR求解器)\n"
+              << "      --temporal <次数>     带状矩阵的时间分块：每组扫描次数，组末检查收敛 (默认: 1 不分块)\n"
+              << "  -p, --operator <算子>      使用矩阵自由算子代替配置文件中的矩阵 A\n"
+              << "                           可选值: poisson1d, poisson2d, poisson3d\n"
+              << "  -g, --grid <点数>          设置算子每个维度的网格点数\n"
+              << "  -f, --format <格式>        显式矩阵的存储格式 (默认: csr)\n"
+              << "                           可选值: csr, compressed (16位列号差值 + 数值字典), dia, ell, sell,\n"
+              << "                           auto (按稀疏结构选择), bench (对各格式做 SpMV/SOR 扫描微基准后选择)\n"
+              << "  -j, --threads <线程数>     设置并行线程数 (默认: 使用配置文件或 OpenMP 默认值)\n"
+              << "  -a, --affinity <策略>      设置线程绑定策略 (默认: none)\n"
+              << "                           可选值: none, compact, scatter\n"
+              << "      --perf                性能分析：测量 roofline 并报告各阶段的硬件计数器、GB/s 与 GFLOP/s\n"
+              << "      --cache <目录>        在目录中缓存 LU 分解，再次求解同一矩阵时跳过分解 (仅用于gauss求解器)\n"
               << "  -q, --quiet               安静模式，减少输出信息\n"
               << "  -v, --verbose             详细模式，显示更多信息\n\n"
               << "示例:\n"
               << "  " << programName << " config.ini                    # 使用配置文件中的设置\n"
               << "  " << programName << " input.ini -s sor -w 1.2      # 使用SOR求解器，松弛因子为1.2\n"
               << "  " << programName << " data.ini -t 1e-8 -m 2000     # 设置精度和最大迭代次数\n"
+              << "  " << programName << " config.ini -s jacobi -p poisson2d -g 256  # 256×256 网格泊松方程\n"
+              << "  " << programName << " big.ini -s jacobi -j 32 -a scatter  # 32线程并分散绑定到各NUMA节点\n"
               << std::endl;
 }
 
@@ -121,8 +182,16 @@ struct ProgramOptions
     double tolerance = -1; // -1表示使用配置文件中的值
     int maxIterations = -1;
     double omega = 1.5;
+    int temporalSweeps = -1; // -1表示使用配置文件中的值
+    std::string operatorType;
+    int gridSize = -1;
+    std::string format;
+    int threads = -1; // -1表示使用配置文件中的值
+    std::string affinity;
+    std::string cacheDirectory;
     bool quiet = false;
     bool verbose = false;
+    bool perf = false;
 };
 
 ProgramOptions parseArguments(int argc, char *argv[])
@@ -199,6 +268,73 @@ ProgramOptions parseArguments(int argc, char *argv[])
             }
             options.omega = std::stod(argv[i]);
         }
+        else if (arg == "-p" || arg == "--operator")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "错误: -p/--operator 选项需要一个参数" << std::endl;
+                exit(1);
+            }
+            options.operatorType = argv[i];
+        }
+        else if (arg == "-g" || arg == "--grid")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "错误: -g/--grid 选项需要一个参数" << std::endl;
+                exit(1);
+            }
+            options.gridSize = std::stoi(argv[i]);
+        }
+        else if (arg == "-f" || arg == "--format")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "错误: -f/--format 选项需要一个参数" << std::endl;
+                exit(1);
+            }
+            options.format = argv[i];
+        }
+        else if (arg == "-j" || arg == "--threads")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "错误: -j/--threads 选项需要一个参数" << std::endl;
+                exit(1);
+            }
+            options.threads = std::stoi(argv[i]);
+        }
+        else if (arg == "-a" || arg == "--affinity")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "错误: -a/--affinity 选项需要一个参数" << std::endl;
+                exit(1);
+            }
+            options.affinity = argv[i];
+        }
+        else if (arg == "--perf")
+        {
+            options.perf = true;
+        }
+        else if (arg == "--temporal")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "错误: --temporal 选项需要一个参数" << std::endl;
+                exit(1);
+            }
+            options.temporalSweeps = std::stoi(argv[i]);
+        }
+        else if (arg == "--cache")
+        {
+            if (++i >= argc)
+            {
+                std::cerr << "错误: --cache 选项需要一个参数" << std::endl;
+                exit(1);
+            }
+            options.cacheDirectory = argv[i];
+        }
         else if (arg == "-q" || arg == "--quiet")
         {
             options.quiet = true;
@@ -240,6 +376,31 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // 设置线程数与线程绑定，须在首次写入矩阵数据之前完成
+    int threads = options.threads > 0 ? options.threads : config.getThreads();
+    std::string affinityName = options.affinity.empty() ? config.getAffinity() : options.affinity;
+    AffinityMode affinity;
+    if (!parseAffinityMode(affinityName, affinity))
+    {
+        std::cerr << "未知的线程绑定策略: " << affinityName << std::endl;
+        return 1;
+    }
+    setupThreads(threads, affinity);
+
+    if (options.verbose)
+    {
+        std::cout << "并行线程数: " << threadCount()
+                  << ", 线程绑定: " << affinityModeName(affinity) << std::endl;
+    }
+
+    // 性能分析须在线程设置之后创建，以便为每个线程打开计数器
+    std::unique_ptr<Profiler> profiler;
+    if (options.perf)
+    {
+        profiler.reset(new Profiler());
+        profiler->measureRoofline();
+    }
+
     // 创建求解器
     std::unique_ptr<Solver> solver;
     std::string solverType = options.solverType.empty() ? config.getSolverType() : options.solverType;
@@ -267,9 +428,112 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    // 获取矩阵和向量
-    auto A = config.getMatrixA();
-    auto b = config.getVectorB();
+    // 获取矩阵 (或矩阵自由算子) 和向量
+    std::string operatorType = options.operatorType.empty() ? config.getOperatorType() : options.operatorType;
+    std::shared_ptr<LinearOperator> op;
+    bool matrixFree = !operatorType.empty();
+    int n = 0;
+
+    if (!operatorType.empty())
+    {
+        int dim = PoissonOperator::parseDimension(operatorType);
+        int grid = options.gridSize > 0 ? options.gridSize : config.getGridSize();
+        if (dim == 0)
+        {
+            std::cerr << "未知的算子类型: " << operatorType << std::endl;
+            return 1;
+        }
+        if (grid <= 0)
+        {
+            std::cerr << "错误: 矩阵自由算子需要指定网格点数 (grid)" << std::endl;
+            return 1;
+        }
+        op = std::make_shared<PoissonOperator>(dim, grid);
+        n = op->size();
+    }
+    else
+    {
+        // 文本矩阵直接并行解析为 CSR
+        Timer parseTimer;
+        if (profiler)
+        {
+            profiler->begin("解析");
+        }
+        auto csr = std::make_shared<CsrMatrix>();
+        if (!config.getSparseMatrixA(*csr))
+        {
+            return 1;
+        }
+        if (profiler)
+        {
+            // 解析阶段只统计写出的 CSR 数组，文本读取量不计入
+            profiler->end(CsrOperator(csr).matrixBytes(), 0.0);
+        }
+        std::string format = options.format.empty() ? config.getMatrixFormat() : options.format;
+        if (format == "auto" || format == "bench")
+        {
+            auto analysis = FormatSelector::analyze(*csr);
+            std::string reason;
+            if (format == "auto")
+            {
+                format = FormatSelector::choose(analysis, solverType == "sor", reason);
+                op = FormatSelector::create(format, csr);
+            }
+            else
+            {
+                std::vector<std::pair<std::string, double> > times;
+                op = FormatSelector::benchmark(csr, analysis, solverType == "sor", times, format);
+                reason = solverType == "sor" ? "SOR 扫描微基准:" : "SpMV 微基准:";
+                for (const auto &t : times)
+                {
+                    reason += " " + t.first + " " + std::to_string(t.second) + "ms";
+                }
+            }
+
+            if (!options.quiet)
+            {
+                std::cout << "存储格式: " << op->name() << " (" << reason << ")，填充率 "
+                          << FormatSelector::fillRatio(analysis, format) << std::endl;
+            }
+        }
+        else
+        {
+            op = FormatSelector::create(format, csr);
+        }
+        if (!op)
+        {
+            std::cerr << "未知的矩阵存储格式: " << format << std::endl;
+            return 1;
+        }
+        n = op->size();
+
+        if (options.verbose)
+        {
+            std::cout << "矩阵解析耗时: " << parseTimer.getElapsedMilliseconds() << "ms, 非零元素: "
+                      << csr->values.size() << std::endl;
+            std::cout << "存储格式: " << op->name() << ", 每个非零元 "
+                      << op->matrixBytes() / std::max<size_t>(csr->values.size(), 1) << " 字节" << std::endl;
+        }
+    }
+
+    std::vector<std::vector<double> > rhs;
+    if (!config.getRightHandSides(rhs))
+        return 1;
+    if (matrixFree && !rhs.empty() && static_cast<int>(rhs[0].size()) != n)
+    {
+        std::cout << "警告：配置文件中的 b 与算子规模不符，改用 b = 1" << std::endl;
+        rhs.clear();
+    }
+    if (rhs.empty())
+    {
+        if (!matrixFree)
+        {
+            std::cerr << "错误: 配置文件缺少常数向量 b" << std::endl;
+            return 1;
+        }
+        rhs.push_back(std::vector<double>(n, 1.0)); // 算子模式默认 b = 1
+    }
+    const int k = rhs.size();
 
     // 设置参数
     double tolerance = options.tolerance > 0 ? options.tolerance : config.getTolerance();
@@ -279,10 +543,16 @@ int main(int argc, char *argv[])
     {
         std::cout << "求解精度: " << tolerance << std::endl;
         std::cout << "最大迭代次数: " << maxIterations << std::endl;
+        if (k > 1)
+        {
+            std::cout << "右端项个数: " << k << std::endl;
+        }
     }
 
     solver->setParameters(tolerance, maxIterations);
-    solver->setEquation(A, b);
+    solver->setTemporalBlocking(options.temporalSweeps > 0 ? options.temporalSweeps : config.getTemporalSweeps());
+    solver->setVerbose(!options.quiet);
+    solver->setOperator(op, rhs[0]);
 
     // 检查矩阵可解性
     if (!solver->checkSolvability())
@@ -291,19 +561,114 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    // 设置初始解向量
-    std::vector<double> x(config.getMatrixSize(), 0.0);
+    // 性能分析时把 LU 分解单独作为一个阶段
+    GaussSolver *gauss = dynamic_cast<GaussSolver *>(solver.get());
+    std::string cacheDirectory = options.cacheDirectory.empty() ? config.getCacheDirectory() : options.cacheDirectory;
+    if (gauss && !cacheDirectory.empty())
+    {
+        gauss->setFactorCache(std::make_shared<FactorCache>(cacheDirectory, config.getCacheMaxBytes(),
+                                                            config.getCacheMaxEntries()));
+    }
+    if (profiler && gauss)
+    {
+        profiler->begin("LU 分解");
+        if (!gauss->factorize())
+        {
+            std::cerr << "求解失败" << std::endl;
+            return 1;
+        }
+        profiler->end(solver->getWorkEstimate().bytes, solver->getWorkEstimate().flops);
+    }
+
+    std::vector<std::vector<double> > xs(k, std::vector<double>(n, 0.0));
+    std::vector<int> iterations(1, 0);
+    bool success = false;
+    double solveTime = 0.0;
+
+    if (k == 1)
+    {
+        // 求解方程
+        Timer solveTimer("求解");
+        if (profiler)
+        {
+            profiler->begin("求解");
+        }
+        success = solver->solve(xs[0]);
+        solveTime = solveTimer.getElapsedMilliseconds();
+        iterations[0] = solver->getIterations();
+        if (solver->getTemporalBlocking() > 1 && !gauss && !options.quiet)
+        {
+            if (solver->getTemporalTileRows() > 0)
+                std::cout << "时间分块: 每组 " << solver->getTemporalBlocking() << " 次扫描，行块 "
+                          << solver->getTemporalTileRows() << " 行" << std::endl;
+            else
+                std::cout << "时间分块未启用: 矩阵不是带状或带宽相对缓存过大" << std::endl;
+        }
+    }
+    else
+    {
+        // 多右端项：按 n×k 行交错存储，一次扫描 A 更新全部列
+        std::vector<double> B(static_cast<size_t>(n) * k);
+        for (int c = 0; c < k; ++c)
+        {
+            if (static_cast<int>(rhs[c].size()) != n)
+            {
+                std::cerr << "错误：第 " << c + 1 << " 个右端项维度不匹配" << std::endl;
+                return 1;
+            }
+            for (int i = 0; i < n; ++i)
+            {
+                B[static_cast<size_t>(i) * k + c] = rhs[c][i];
+            }
+        }
+        solver->setRightHandSides(B, k);
+
+        std::vector<double> X(static_cast<size_t>(n) * k, 0.0);
+        Timer solveTimer("求解");
+        if (profiler)
+        {
+            profiler->begin("求解");
+        }
+        success = solver->solveBlock(X);
+        solveTime = solveTimer.getElapsedMilliseconds();
+
+        for (int c = 0; c < k; ++c)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                xs[c][i] = X[static_cast<size_t>(i) * k + c];
+            }
+        }
+        iterations = solver->getColumnIterations();
+    }
+
+    if (profiler)
+    {
+        profiler->end(solver->getWorkEstimate().bytes, solver->getWorkEstimate().flops);
+        profiler->report(std::cout);
+    }
 
-    // 求解方程
-    Timer solveTimer("求解");
-    bool success = solver->solve(x);
-    double solveTime = solveTimer.getElapsedMilliseconds();
+    if (success && gauss && !cacheDirectory.empty() && !options.quiet)
+    {
+        if (gauss->factorLoaded())
+        {
+            std::cout << "LU 分解取自缓存: " << cacheDirectory << std::endl;
+        }
+        else if (gauss->factorStored())
+        {
+            std::cout << "LU 分解缓存未命中，已分解并写入: " << cacheDirectory << std::endl;
+        }
+        else
+        {
+            std::cout << "LU 分解缓存未命中，已分解但写入失败: " << cacheDirectory << std::endl;
+        }
+    }
 
     if (success)
     {
         // 保存结果到文件
-        saveResults(options.outputFile, A, b, x, solverType,
-                    tolerance, maxIterations, 0, solveTime);
+        saveResults(options.outputFile, *op, matrixFree, rhs, xs, solverType,
+                    tolerance, maxIterations, iterations, solveTime, profiler.get());
 
         if (!options.quiet)
         {
@@ -0,0 +1,381 @@
+#include "../../include/operators/compressed_csr_operator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace
+{
+    const int kMaxDelta = 0xFFFF;
+
+    struct RawValues
+    {
+        const double *values;
+        double operator()(int k) const { return values[k]; }
+    };
+
+    template <typename Code>
+    struct DictValues
+    {
+        const Code *codes;
+        const double *dictionary;
+        double operator()(int k) const { return dictionary[codes[k]]; }
+    };
+
+    // 按位模式区分数值，保证 -0.0 与 0.0 等经字典往返后完全不变
+    uint64_t valueKey(double v)
+    {
+        uint64_t key;
+        std::memcpy(&key, &v, sizeof(key));
+        return key;
+    }
+}
+
+CompressedCsrOperator::CompressedCsrOperator(int n, const int *rowPtr, const int *colIdx,
+                                             const double *values, bool useDictionary)
+    : n_(n)
+{
+    // 第一步：每行按列号排序并合并重复列，结果暂存在原位置，统计合并后的元素数与差值流长度
+    const int total = rowPtr[n];
+    std::vector<int> cols(colIdx, colIdx + total);
+    std::vector<double> vals(values, values + total);
+    std::vector<int> rowLength(n);
+    std::vector<int> rowWords(n);
+
+#pragma omp parallel
+    {
+        std::vector<std::pair<int, double> > entries;
+
+#pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            const int begin = rowPtr[i];
+            const int end = rowPtr[i + 1];
+            int length = end - begin;
+
+            bool sorted = true;
+            for (int k = begin + 1; k < end && sorted; ++k)
+            {
+                sorted = cols[k] > cols[k - 1];
+            }
+            if (!sorted)
+            {
+                entries.clear();
+                for (int k = begin; k < end; ++k)
+                {
+                    entries.emplace_back(cols[k], vals[k]);
+                }
+                std::stable_sort(entries.begin(), entries.end(),
+                                 [](const std::pair<int, double> &a, const std::pair<int, double> &b) {
+                                     return a.first < b.first;
+                                 });
+                length = 0;
+                for (const auto &e : entries)
+                {
+                    if (length > 0 && cols[begin + length - 1] == e.first)
+                    {
+                        vals[begin + length - 1] += e.second;
+                    }
+                    else
+                    {
+                        cols[begin + length] = e.first;
+                        vals[begin + length] = e.second;
+                        ++length;
+                    }
+                }
+            }
+
+            int words = 0;
+            for (int k = begin + 1; k < begin + length; ++k)
+            {
+                words += cols[k] - cols[k - 1] <= kMaxDelta ? 1 : 3;
+            }
+            rowLength[i] = length;
+            rowWords[i] = words;
+        }
+    }
+
+    valPtr_.resize(n + 1);
+    idxPtr_.resize(n + 1);
+    rowBase_.resize(n);
+    valPtr_[0] = 0;
+    idxPtr_[0] = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        valPtr_[i + 1] = valPtr_[i] + rowLength[i];
+        idxPtr_[i + 1] = idxPtr_[i] + rowWords[i];
+    }
+
+    // 第二步：统计不同数值，超过 65536 个时放弃字典
+    std::unordered_map<uint64_t, int> index;
+    if (useDictionary)
+    {
+        for (int i = 0; i < n && index.size() <= 0x10000; ++i)
+        {
+            for (int k = rowPtr[i]; k < rowPtr[i] + rowLength[i]; ++k)
+            {
+                if (index.emplace(valueKey(vals[k]), static_cast<int>(dictionary_.size())).second)
+                {
+                    dictionary_.push_back(vals[k]);
+                }
+            }
+        }
+    }
+    if (useDictionary && dictionary_.size() <= 0x100)
+    {
+        mode_ = ValueMode::Dict8;
+        codes8_.resize(valPtr_[n]);
+    }
+    else if (useDictionary && dictionary_.size() <= 0x10000)
+    {
+        mode_ = ValueMode::Dict16;
+        codes16_.resize(valPtr_[n]);
+    }
+    else
+    {
+        mode_ = ValueMode::Raw;
+        dictionary_.clear();
+        index.clear();
+        values_.resize(valPtr_[n]);
+    }
+    deltas_.resize(idxPtr_[n]);
+
+    // 第三步：按与求解相同的静态行划分写入压缩数据，完成首次写入
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        const int src = rowPtr[i];
+        const int dst = valPtr_[i];
+        const int length = rowLength[i];
+        rowBase_[i] = length > 0 ? cols[src] : 0;
+
+        uint16_t *d = deltas_.data() + idxPtr_[i];
+        for (int k = 1; k < length; ++k)
+        {
+            const int delta = cols[src + k] - cols[src + k - 1];
+            if (delta <= kMaxDelta)
+            {
+                *d++ = static_cast<uint16_t>(delta);
+            }
+            else
+            {
+                *d++ = 0;
+                *d++ = static_cast<uint16_t>(cols[src + k] >> 16);
+                *d++ = static_cast<uint16_t>(cols[src + k] & 0xFFFF);
+            }
+        }
+
+        for (int k = 0; k < length; ++k)
+        {
+            const double v = vals[src + k];
+            switch (mode_)
+            {
+            case ValueMode::Dict8:
+                codes8_[dst + k] = static_cast<uint8_t>(index.find(valueKey(v))->second);
+                break;
+            case ValueMode::Dict16:
+                codes16_[dst + k] = static_cast<uint16_t>(index.find(valueKey(v))->second);
+                break;
+            case ValueMode::Raw:
+                values_[dst + k] = v;
+                break;
+            }
+        }
+    }
+}
+
+template <typename Values, typename Fn>
+inline void CompressedCsrOperator::visitRow(int i, const Values &values, Fn &&fn) const
+{
+    int k = valPtr_[i];
+    const int end = valPtr_[i + 1];
+    if (k == end)
+    {
+        return;
+    }
+
+    const uint16_t *d = deltas_.data() + idxPtr_[i];
+    int col = rowBase_[i];
+    fn(col, values(k));
+    for (++k; k < end; ++k)
+    {
+        const uint16_t delta = *d++;
+        if (delta)
+        {
+            col += delta;
+        }
+        else
+        {
+            col = (static_cast<int>(d[0]) << 16) | d[1];
+            d += 2;
+        }
+        fn(col, values(k));
+    }
+}
+
+template <typename Fn>
+inline void CompressedCsrOperator::dispatch(Fn &&fn) const
+{
+    switch (mode_)
+    {
+    case ValueMode::Dict8:
+        fn(DictValues<uint8_t>{codes8_.data(), dictionary_.data()});
+        break;
+    case ValueMode::Dict16:
+        fn(DictValues<uint16_t>{codes16_.data(), dictionary_.data()});
+        break;
+    case ValueMode::Raw:
+        fn(RawValues{values_.data()});
+        break;
+    }
+}
+
+double CompressedCsrOperator::diagonal(int i) const
+{
+    double diag = 0.0;
+    dispatch([&](const auto &values) {
+        visitRow(i, values, [&](int j, double a) {
+            if (j == i)
+                diag = a;
+        });
+    });
+    return diag;
+}
+
+double CompressedCsrOperator::rowDot(int i, const double *x) const
+{
+    double sum = 0.0;
+    dispatch([&](const auto &values) {
+        visitRow(i, values, [&](int j, double a) { sum += a * x[j]; });
+    });
+    return sum;
+}
+
+void CompressedCsrOperator::rowDotBlock(int i, const double *X, int m, double *out) const
+{
+    std::fill(out, out + m, 0.0);
+    dispatch([&](const auto &values) {
+        visitRow(i, values, [&](int j, double a) {
+            const double *x = X + static_cast<size_t>(j) * m;
+            for (int q = 0; q < m; ++q)
+            {
+                out[q] += a * x[q];
+            }
+        });
+    });
+}
+
+void CompressedCsrOperator::copyRow(int i, double *row) const
+{
+    std::fill(row, row + n_, 0.0);
+    dispatch([&](const auto &values) {
+        visitRow(i, values, [&](int j, double a) { row[j] = a; });
+    });
+}
+
+double CompressedCsrOperator::offDiagonalAbsSum(int i) const
+{
+    double sum = 0.0;
+    dispatch([&](const auto &values) {
+        visitRow(i, values, [&](int j, double a) {
+            if (j != i)
+                sum += std::abs(a);
+        });
+    });
+    return sum;
+}
+
+void CompressedCsrOperator::apply(const double *x, double *y) const
+{
+    // 数值存储方式在整个扫描中不变，分派移到行循环之外
+    dispatch([&](const auto &values) {
+#pragma omp parallel for schedule(static)
+        for (int i = 0; i < n_; ++i)
+        {
+            double sum = 0.0;
+            visitRow(i, values, [&](int j, double a) { sum += a * x[j]; });
+            y[i] = sum;
+        }
+    });
+}
+
+double CompressedCsrOperator::sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                                       double *x) const
+{
+    double maxDiff = 0.0;
+    dispatch([&](const auto &values) {
+        for (int i = begin; i < end; ++i)
+        {
+            double sum = 0.0;
+            visitRow(i, values, [&](int j, double a) { sum += a * x[j]; });
+            double delta = omega * (b[i] - sum) / diag[i];
+            x[i] += delta;
+            maxDiff = std::max(maxDiff, std::abs(delta));
+        }
+    });
+    return maxDiff;
+}
+
+double CompressedCsrOperator::jacobiSweep(int begin, int end, const double *b, const double *diag,
+                                          const double *x, double *xNew) const
+{
+    double maxDiff = 0.0;
+    dispatch([&](const auto &values) {
+#pragma omp parallel
+        {
+            double localDiff = 0.0;
+#pragma omp for schedule(static)
+            for (int i = begin; i < end; ++i)
+            {
+                double sum = 0.0;
+                visitRow(i, values, [&](int j, double a) { sum += a * x[j]; });
+                double delta = (b[i] - sum) / diag[i];
+                xNew[i] = x[i] + delta;
+                localDiff = std::max(localDiff, std::abs(delta));
+            }
+#pragma omp critical
+            maxDiff = std::max(maxDiff, localDiff);
+        }
+    });
+    return maxDiff;
+}
+
+int CompressedCsrOperator::bandwidth() const
+{
+    int width = 0;
+    dispatch([&](const auto &values) {
+#pragma omp parallel for schedule(static) reduction(max : width)
+        for (int i = 0; i < n_; ++i)
+        {
+            visitRow(i, values, [&](int j, double) {
+                width = std::max(width, std::abs(j - i));
+            });
+        }
+    });
+    return width;
+}
+
+double CompressedCsrOperator::matrixBytes() const
+{
+    double valueBytes = 8.0;
+    if (mode_ == ValueMode::Dict8)
+        valueBytes = 1.0;
+    else if (mode_ == ValueMode::Dict16)
+        valueBytes = 2.0;
+    return valueBytes * nonZeros() + 2.0 * deltas_.size() + 12.0 * n_ + 8.0 * dictionary_.size();
+}
+
+std::string CompressedCsrOperator::name() const
+{
+    switch (mode_)
+    {
+    case ValueMode::Dict8:
+        return "csr16+dict8";
+    case ValueMode::Dict16:
+        return "csr16+dict16";
+    case ValueMode::Raw:
+        break;
+    }
+    return "csr16";
+}
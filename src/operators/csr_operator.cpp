@@ -0,0 +1,114 @@
+#include "../../include/operators/csr_operator.h"
+#include <algorithm>
+#include <cmath>
+
+double CsrOperator::diagonal(int i) const
+{
+    for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+    {
+        if (colIdx_[k] == i)
+            return values_[k];
+    }
+    return 0.0;
+}
+
+double CsrOperator::rowDot(int i, const double *x) const
+{
+    double sum = 0.0;
+    for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+    {
+        sum += values_[k] * x[colIdx_[k]];
+    }
+    return sum;
+}
+
+void CsrOperator::rowDotBlock(int i, const double *X, int m, double *out) const
+{
+    std::fill(out, out + m, 0.0);
+    for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+    {
+        const double a = values_[k];
+        const double *x = X + static_cast<size_t>(colIdx_[k]) * m;
+        for (int q = 0; q < m; ++q)
+        {
+            out[q] += a * x[q];
+        }
+    }
+}
+
+void CsrOperator::copyRow(int i, double *row) const
+{
+    std::fill(row, row + n_, 0.0);
+    for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+    {
+        row[colIdx_[k]] += values_[k];
+    }
+}
+
+double CsrOperator::sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                             double *x) const
+{
+    double maxDiff = 0.0;
+    for (int i = begin; i < end; ++i)
+    {
+        double sum = 0.0;
+        for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+        {
+            sum += values_[k] * x[colIdx_[k]];
+        }
+        double delta = omega * (b[i] - sum) / diag[i];
+        x[i] += delta;
+        maxDiff = std::max(maxDiff, std::abs(delta));
+    }
+    return maxDiff;
+}
+
+double CsrOperator::jacobiSweep(int begin, int end, const double *b, const double *diag,
+                                const double *x, double *xNew) const
+{
+    double maxDiff = 0.0;
+#pragma omp parallel
+    {
+        double localDiff = 0.0;
+#pragma omp for schedule(static)
+        for (int i = begin; i < end; ++i)
+        {
+            double sum = 0.0;
+            for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+            {
+                sum += values_[k] * x[colIdx_[k]];
+            }
+            double delta = (b[i] - sum) / diag[i];
+            xNew[i] = x[i] + delta;
+            localDiff = std::max(localDiff, std::abs(delta));
+        }
+#pragma omp critical
+        maxDiff = std::max(maxDiff, localDiff);
+    }
+    return maxDiff;
+}
+
+int CsrOperator::bandwidth() const
+{
+    int width = 0;
+#pragma omp parallel for schedule(static) reduction(max : width)
+    for (int i = 0; i < n_; ++i)
+    {
+        for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+        {
+            width = std::max(width, std::abs(colIdx_[k] - i));
+        }
+    }
+    return width;
+}
+
+double CsrOperator::offDiagonalAbsSum(int i) const
+{
+    double sum = 0.0;
+    for (int k = rowPtr_[i]; k < rowPtr_[i + 1]; ++k)
+    {
+        if (colIdx_[k] != i)
+            sum += std::abs(values_[k]);
+    }
+    return sum;
+}
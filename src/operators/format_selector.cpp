@@ -0,0 +1,176 @@
+#include "../../include/operators/format_selector.h"
+#include "../../include/operators/compressed_csr_operator.h"
+#include "../../include/operators/dia_operator.h"
+#include "../../include/operators/ell_operator.h"
+#include "../../include/operators/sell_operator.h"
+#include "../../include/utils/timer.h"
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+    // DIA 不存列号，每个存储元素 8 字节：填充率不超过 1.5 时访存量已不多于 CSR 的 12 字节
+    const double kDiaMaxFill = 1.5;
+    // ELLPACK/SELL 与 CSR 同为每元素 12 字节，只允许少量补齐以换取向量化
+    const double kEllMaxFill = 1.1;
+    const double kSellMaxFill = 1.25;
+    // 平均行长超过此值时 CSR 的行内循环已足够长，跨行向量化得不偿失
+    const double kVectorMaxRowLength = 32.0;
+    // 微基准中填充率超过此值的格式不构造
+    const double kBenchmarkMaxFill = 3.0;
+    const int kBenchmarkRuns = 3;
+
+    std::string formatRatio(double value)
+    {
+        std::ostringstream out;
+        out.precision(3);
+        out << value;
+        return out.str();
+    }
+}
+
+FormatSelector::Analysis FormatSelector::analyze(const CsrMatrix &A)
+{
+    Analysis analysis;
+    const int n = A.n;
+    analysis.n = n;
+    analysis.nonZeros = A.rowPtr[n];
+    for (int i = 0; i < n; ++i)
+    {
+        analysis.maxRowLength = std::max(analysis.maxRowLength, A.rowPtr[i + 1] - A.rowPtr[i]);
+    }
+    analysis.meanRowLength = n > 0 ? static_cast<double>(analysis.nonZeros) / n : 0.0;
+    analysis.diagonals = DiaOperator::countDiagonals(n, A.rowPtr.data(), A.colIdx.data());
+
+    if (analysis.nonZeros > 0)
+    {
+        const double nnz = analysis.nonZeros;
+        analysis.diaFill = static_cast<double>(analysis.diagonals) * n / nnz;
+        analysis.ellFill = static_cast<double>(analysis.maxRowLength) * n / nnz;
+        analysis.sellFill = SellOperator::storedEntries(n, A.rowPtr.data()) / nnz;
+    }
+    return analysis;
+}
+
+std::string FormatSelector::choose(const Analysis &analysis, bool sequentialSweep, std::string &reason)
+{
+    if (analysis.nonZeros == 0)
+    {
+        reason = "零矩阵";
+        return "csr";
+    }
+    if (analysis.diaFill <= kDiaMaxFill)
+    {
+        reason = "非零元集中在 " + std::to_string(analysis.diagonals) + " 条对角线上";
+        return "dia";
+    }
+    if (sequentialSweep)
+    {
+        reason = "SOR 逐行扫描，对角线分散时按行连续存储最快";
+        return "csr";
+    }
+    if (analysis.meanRowLength > kVectorMaxRowLength)
+    {
+        reason = "平均行长 " + formatRatio(analysis.meanRowLength) + "，行内循环已足够长";
+        return "csr";
+    }
+    if (analysis.ellFill <= kEllMaxFill)
+    {
+        reason = "行长均匀 (最长 " + std::to_string(analysis.maxRowLength) + "，平均 " +
+                 formatRatio(analysis.meanRowLength) + ")";
+        return "ell";
+    }
+    if (analysis.sellFill <= kSellMaxFill)
+    {
+        reason = "行长不均匀但按块补齐后开销小";
+        return "sell";
+    }
+    reason = "DIA/ELLPACK/SELL 的补齐开销都过大";
+    return "csr";
+}
+
+std::shared_ptr<LinearOperator> FormatSelector::create(const std::string &format,
+                                                       const std::shared_ptr<const CsrMatrix> &A)
+{
+    const int n = A->n;
+    const int *rowPtr = A->rowPtr.data();
+    const int *colIdx = A->colIdx.data();
+    const double *values = A->values.data();
+
+    if (format == "csr")
+        return std::make_shared<CsrOperator>(A);
+    if (format == "compressed")
+        return std::make_shared<CompressedCsrOperator>(n, rowPtr, colIdx, values);
+    if (format == "dia")
+        return std::make_shared<DiaOperator>(n, rowPtr, colIdx, values);
+    if (format == "ell")
+        return std::make_shared<EllOperator>(n, rowPtr, colIdx, values);
+    if (format == "sell")
+        return std::make_shared<SellOperator>(n, rowPtr, colIdx, values);
+    return nullptr;
+}
+
+std::shared_ptr<LinearOperator> FormatSelector::benchmark(const std::shared_ptr<const CsrMatrix> &A,
+                                                          const Analysis &analysis, bool sequentialSweep,
+                                                          std::vector<std::pair<std::string, double> > &times,
+                                                          std::string &format)
+{
+    const int n = A->n;
+    NumaVector x(n);
+    NumaVector y(n);
+    firstTouchFill(x.data(), 1.0, n);
+    firstTouchFill(y.data(), 1.0, n);
+
+    // SOR 扫描取 ω = 0，x 保持不变但每行的内积照常计算
+    auto sweep = [&](const LinearOperator &op) {
+        if (sequentialSweep)
+            op.sorSweep(0, n, y.data(), y.data(), 0.0, x.data());
+        else
+            op.apply(x.data(), y.data());
+    };
+
+    std::shared_ptr<LinearOperator> best;
+    double bestMs = 0.0;
+    times.clear();
+
+    const char *candidates[] = {"csr", "compressed", "dia", "ell", "sell"};
+    for (const char *candidate : candidates)
+    {
+        const std::string name = candidate;
+        if (fillRatio(analysis, name) > kBenchmarkMaxFill ||
+            (sequentialSweep && (name == "ell" || name == "sell")))
+            continue;
+
+        std::shared_ptr<LinearOperator> op = create(candidate, A);
+        sweep(*op); // 预热
+
+        double ms = 0.0;
+        for (int run = 0; run < kBenchmarkRuns; ++run)
+        {
+            Timer timer;
+            sweep(*op);
+            const double elapsed = timer.getElapsedMilliseconds();
+            ms = run == 0 ? elapsed : std::min(ms, elapsed);
+        }
+        times.emplace_back(candidate, ms);
+
+        if (!best || ms < bestMs)
+        {
+            best = op;
+            bestMs = ms;
+            format = candidate;
+        }
+    }
+    return best;
+}
+
+double FormatSelector::fillRatio(const Analysis &analysis, const std::string &format)
+{
+    if (format == "dia")
+        return analysis.diaFill;
+    if (format == "ell")
+        return analysis.ellFill;
+    if (format == "sell")
+        return analysis.sellFill;
+    return 1.0;
+}
@@ -0,0 +1,98 @@
+#include "../../include/operators/poisson_operator.h"
+#include <algorithm>
+#include <stdexcept>
+
+PoissonOperator::PoissonOperator(int dim, int gridSize)
+    : dim_(dim), grid_(gridSize), size_(1)
+{
+    if (dim < 1 || dim > 3 || gridSize < 1)
+    {
+        throw std::invalid_argument("泊松算子维度须为 1-3，网格大小须为正数");
+    }
+    for (int d = 0; d < 3; ++d)
+    {
+        stride_[d] = d < dim ? size_ : 0;
+        if (d < dim)
+            size_ *= gridSize;
+    }
+}
+
+int PoissonOperator::neighbors(int i, int *nb) const
+{
+    int count = 0;
+    for (int d = 0; d < dim_; ++d)
+    {
+        const int coord = (i / stride_[d]) % grid_;
+        if (coord > 0)
+            nb[count++] = i - stride_[d];
+        if (coord < grid_ - 1)
+            nb[count++] = i + stride_[d];
+    }
+    return count;
+}
+
+double PoissonOperator::rowDot(int i, const double *x) const
+{
+    int nb[6];
+    const int count = neighbors(i, nb);
+    double sum = 2.0 * dim_ * x[i];
+    for (int k = 0; k < count; ++k)
+    {
+        sum -= x[nb[k]];
+    }
+    return sum;
+}
+
+void PoissonOperator::rowDotBlock(int i, const double *X, int m, double *out) const
+{
+    int nb[6];
+    const int count = neighbors(i, nb);
+    const double diag = 2.0 * dim_;
+    const double *xi = X + static_cast<size_t>(i) * m;
+    for (int q = 0; q < m; ++q)
+    {
+        out[q] = diag * xi[q];
+    }
+    for (int k = 0; k < count; ++k)
+    {
+        const double *xn = X + static_cast<size_t>(nb[k]) * m;
+        for (int q = 0; q < m; ++q)
+        {
+            out[q] -= xn[q];
+        }
+    }
+}
+
+void PoissonOperator::copyRow(int i, double *row) const
+{
+    int nb[6];
+    const int count = neighbors(i, nb);
+    std::fill(row, row + size_, 0.0);
+    row[i] = 2.0 * dim_;
+    for (int k = 0; k < count; ++k)
+    {
+        row[nb[k]] = -1.0;
+    }
+}
+
+double PoissonOperator::offDiagonalAbsSum(int i) const
+{
+    int nb[6];
+    return neighbors(i, nb);
+}
+
+std::string PoissonOperator::name() const
+{
+    return "poisson" + std::to_string(dim_) + "d";
+}
+
+int PoissonOperator::parseDimension(const std::string &type)
+{
+    if (type == "poisson1d")
+        return 1;
+    if (type == "poisson2d")
+        return 2;
+    if (type == "poisson3d")
+        return 3;
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include "../../include/operators/row_major_operator.h"
+#include <algorithm>
+
+double RowMajorOperator::rowDot(int i, const double *x) const
+{
+    const double *a = row(i);
+    double sum = 0.0;
+    for (int j = 0; j < n_; ++j)
+    {
+        sum += a[j] * x[j];
+    }
+    return sum;
+}
+
+void RowMajorOperator::rowDotBlock(int i, const double *X, int m, double *out) const
+{
+    const double *a = row(i);
+    std::fill(out, out + m, 0.0);
+    for (int j = 0; j < n_; ++j)
+    {
+        const double *x = X + static_cast<size_t>(j) * m;
+        for (int q = 0; q < m; ++q)
+        {
+            out[q] += a[j] * x[q];
+        }
+    }
+}
+
+void RowMajorOperator::copyRow(int i, double *out) const
+{
+    std::copy(row(i), row(i) + n_, out);
+}
@@ -0,0 +1,180 @@
+#include "../../include/operators/sell_operator.h"
+#include <algorithm>
+#include <cmath>
+
+void SellOperator::sortRows(int n, const int *rowPtr, int sigma, std::vector<int> &order)
+{
+    const int padded = (n + kChunk - 1) / kChunk * kChunk;
+    order.assign(padded, -1);
+    for (int i = 0; i < n; ++i)
+    {
+        order[i] = i;
+    }
+
+    auto length = [&](int i) { return rowPtr[i + 1] - rowPtr[i]; };
+    if (sigma > 1)
+    {
+        for (int begin = 0; begin < n; begin += sigma)
+        {
+            const int end = std::min(n, begin + sigma);
+            std::stable_sort(order.begin() + begin, order.begin() + end,
+                             [&](int a, int b) { return length(a) > length(b); });
+        }
+    }
+}
+
+long long SellOperator::storedEntries(int n, const int *rowPtr, int sigma)
+{
+    std::vector<int> order;
+    sortRows(n, rowPtr, sigma, order);
+    long long total = 0;
+    for (size_t c = 0; c < order.size(); c += kChunk)
+    {
+        int width = 0;
+        for (int r = 0; r < kChunk; ++r)
+        {
+            const int i = order[c + r];
+            if (i >= 0)
+                width = std::max(width, rowPtr[i + 1] - rowPtr[i]);
+        }
+        total += static_cast<long long>(width) * kChunk;
+    }
+    return total;
+}
+
+SellOperator::SellOperator(int n, const int *rowPtr, const int *colIdx, const double *values, int sigma)
+    : n_(n), sigma_(sigma)
+{
+    sortRows(n, rowPtr, sigma, order_);
+    position_.resize(n);
+    for (size_t p = 0; p < order_.size(); ++p)
+    {
+        if (order_[p] >= 0)
+            position_[order_[p]] = p;
+    }
+
+    const int chunks = order_.size() / kChunk;
+    chunkPtr_.assign(chunks + 1, 0);
+    for (int c = 0; c < chunks; ++c)
+    {
+        int width = 0;
+        for (int r = 0; r < kChunk; ++r)
+        {
+            const int i = order_[c * kChunk + r];
+            if (i >= 0)
+                width = std::max(width, rowPtr[i + 1] - rowPtr[i]);
+        }
+        chunkPtr_[c + 1] = chunkPtr_[c] + width * kChunk;
+    }
+
+    // 补齐元素值为 0、列号为块内本行 (补齐行为 0 号列)，访问 x 时不会越界
+    colIdx_.resize(chunkPtr_[chunks]);
+    values_.resize(chunkPtr_[chunks]);
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < chunks; ++c)
+    {
+        const int width = (chunkPtr_[c + 1] - chunkPtr_[c]) / kChunk;
+        for (int r = 0; r < kChunk; ++r)
+        {
+            const int i = order_[c * kChunk + r];
+            const int length = i >= 0 ? rowPtr[i + 1] - rowPtr[i] : 0;
+            for (int k = 0; k < width; ++k)
+            {
+                const int pos = chunkPtr_[c] + k * kChunk + r;
+                colIdx_[pos] = k < length ? colIdx[rowPtr[i] + k] : std::max(i, 0);
+                values_[pos] = k < length ? values[rowPtr[i] + k] : 0.0;
+            }
+        }
+    }
+}
+
+template <typename Fn>
+inline void SellOperator::visitRow(int i, Fn &&fn) const
+{
+    const int p = position_[i];
+    const int c = p / kChunk;
+    const int r = p % kChunk;
+    for (int pos = chunkPtr_[c] + r; pos < chunkPtr_[c + 1]; pos += kChunk)
+    {
+        fn(colIdx_[pos], values_[pos]);
+    }
+}
+
+double SellOperator::diagonal(int i) const
+{
+    double diag = 0.0;
+    visitRow(i, [&](int j, double a) {
+        if (j == i)
+            diag += a;
+    });
+    return diag;
+}
+
+double SellOperator::rowDot(int i, const double *x) const
+{
+    double sum = 0.0;
+    visitRow(i, [&](int j, double a) { sum += a * x[j]; });
+    return sum;
+}
+
+void SellOperator::rowDotBlock(int i, const double *X, int m, double *out) const
+{
+    std::fill(out, out + m, 0.0);
+    visitRow(i, [&](int j, double a) {
+        const double *x = X + static_cast<size_t>(j) * m;
+        for (int q = 0; q < m; ++q)
+        {
+            out[q] += a * x[q];
+        }
+    });
+}
+
+void SellOperator::copyRow(int i, double *row) const
+{
+    std::fill(row, row + n_, 0.0);
+    visitRow(i, [&](int j, double a) { row[j] += a; });
+}
+
+void SellOperator::apply(const double *x, double *y) const
+{
+    const int chunks = chunkPtr_.size() - 1;
+
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < chunks; ++c)
+    {
+        double sum[kChunk] = {};
+        for (int pos = chunkPtr_[c]; pos < chunkPtr_[c + 1]; pos += kChunk)
+        {
+#pragma omp simd
+            for (int r = 0; r < kChunk; ++r)
+            {
+                sum[r] += values_[pos + r] * x[colIdx_[pos + r]];
+            }
+        }
+        for (int r = 0; r < kChunk; ++r)
+        {
+            const int i = order_[c * kChunk + r];
+            if (i >= 0)
+                y[i] = sum[r];
+        }
+    }
+}
+
+double SellOperator::sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                              double *x) const
+{
+    // 按原始行序更新，保持与 CSR 相同的 Gauss-Seidel 顺序
+    double maxDiff = 0.0;
+    for (int i = begin; i < end; ++i)
+    {
+        double delta = omega * (b[i] - SellOperator::rowDot(i, x)) / diag[i];
+        x[i] += delta;
+        maxDiff = std::max(maxDiff, std::abs(delta));
+    }
+    return maxDiff;
+}
+
+std::string SellOperator::name() const
+{
+    return "sell-" + std::to_string(kChunk) + "-" + std::to_string(sigma_);
+}
@@ -0,0 +1,462 @@
+#include "../../include/operators/updated_operator.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace
+{
+    // 单行访问是 O(n·k) 的，出现在并行区内说明被当作扫描内核使用
+    void assertNotInSweep()
+    {
+#ifdef _OPENMP
+        assert(omp_get_level() == 0 && "UpdatedOperator 的单行访问不能用于逐行扫描");
+#endif
+    }
+}
+
+UpdatedOperator::UpdatedOperator(std::shared_ptr<const LinearOperator> base)
+    : base_(base), uUsed_(base->size(), 0), vUsed_(base->size(), 0), slot_(base->size(), -1)
+{
+}
+
+void UpdatedOperator::addLowRank(const double *U, const double *V, int k)
+{
+    const int n = size();
+    const int r = rank_ + k;
+    std::vector<double> Un(static_cast<size_t>(n) * r);
+    std::vector<double> Vn(static_cast<size_t>(n) * r);
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        double *u = &Un[static_cast<size_t>(i) * r];
+        double *v = &Vn[static_cast<size_t>(i) * r];
+        const double *uOld = U_.data() + static_cast<size_t>(i) * rank_;
+        const double *vOld = V_.data() + static_cast<size_t>(i) * rank_;
+        std::copy(uOld, uOld + rank_, u);
+        std::copy(vOld, vOld + rank_, v);
+        for (int c = 0; c < k; ++c)
+        {
+            u[rank_ + c] = U[static_cast<size_t>(i) * k + c];
+            v[rank_ + c] = V[static_cast<size_t>(i) * k + c];
+            uUsed_[i] |= u[rank_ + c] != 0.0;
+            vUsed_[i] |= v[rank_ + c] != 0.0;
+        }
+    }
+
+    U_.swap(Un);
+    V_.swap(Vn);
+    rank_ = r;
+}
+
+void UpdatedOperator::addEntry(int i, int j, double value)
+{
+    if (slot_[i] < 0)
+    {
+        slot_[i] = entries_.size();
+        entries_.emplace_back();
+    }
+    auto &row = entries_[slot_[i]];
+    for (auto &e : row)
+    {
+        if (e.first == j)
+        {
+            e.second += value;
+            return;
+        }
+    }
+    row.emplace_back(j, value);
+    ++sparseCount_;
+}
+
+double UpdatedOperator::sparseDot(int i, const double *x) const
+{
+    if (slot_[i] < 0)
+    {
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (const auto &e : entries_[slot_[i]])
+    {
+        sum += e.second * x[e.first];
+    }
+    return sum;
+}
+
+void UpdatedOperator::sparseDotBlock(int i, const double *X, int m, double *out) const
+{
+    if (slot_[i] < 0)
+    {
+        return;
+    }
+    for (const auto &e : entries_[slot_[i]])
+    {
+        const double *x = X + static_cast<size_t>(e.first) * m;
+        for (int q = 0; q < m; ++q)
+        {
+            out[q] += e.second * x[q];
+        }
+    }
+}
+
+void UpdatedOperator::projectV(const double *x, double *w) const
+{
+    const int n = size();
+    const int r = rank_;
+    std::fill(w, w + r, 0.0);
+
+#pragma omp parallel
+    {
+        std::vector<double> local(r, 0.0);
+#pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            if (!vUsed_[i])
+                continue;
+            const double *v = &V_[static_cast<size_t>(i) * r];
+            for (int c = 0; c < r; ++c)
+            {
+                local[c] += v[c] * x[i];
+            }
+        }
+#pragma omp critical
+        for (int c = 0; c < r; ++c)
+            w[c] += local[c];
+    }
+}
+
+void UpdatedOperator::projectVBlock(const double *X, int m, double *W) const
+{
+    const int n = size();
+    const int r = rank_;
+    std::fill(W, W + static_cast<size_t>(r) * m, 0.0);
+    for (int i = 0; i < n; ++i)
+    {
+        if (!vUsed_[i])
+            continue;
+        const double *v = &V_[static_cast<size_t>(i) * r];
+        const double *x = X + static_cast<size_t>(i) * m;
+        for (int c = 0; c < r; ++c)
+        {
+            for (int q = 0; q < m; ++q)
+            {
+                W[static_cast<size_t>(c) * m + q] += v[c] * x[q];
+            }
+        }
+    }
+}
+
+double UpdatedOperator::lowRankDot(int i, const double *w) const
+{
+    const double *u = &U_[static_cast<size_t>(i) * rank_];
+    double sum = 0.0;
+    for (int c = 0; c < rank_; ++c)
+    {
+        sum += u[c] * w[c];
+    }
+    return sum;
+}
+
+void UpdatedOperator::lowRankDotBlock(int i, const double *W, int m, double *out) const
+{
+    const double *u = &U_[static_cast<size_t>(i) * rank_];
+    for (int c = 0; c < rank_; ++c)
+    {
+        for (int q = 0; q < m; ++q)
+        {
+            out[q] += u[c] * W[static_cast<size_t>(c) * m + q];
+        }
+    }
+}
+
+double UpdatedOperator::lowRankRowDot(int i, const double *x) const
+{
+    const int n = size();
+    const double *u = &U_[static_cast<size_t>(i) * rank_];
+    double sum = 0.0;
+    for (int j = 0; j < n; ++j)
+    {
+        if (!vUsed_[j])
+            continue;
+        const double *v = &V_[static_cast<size_t>(j) * rank_];
+        double a = 0.0;
+        for (int c = 0; c < rank_; ++c)
+        {
+            a += u[c] * v[c];
+        }
+        sum += a * x[j];
+    }
+    return sum;
+}
+
+double UpdatedOperator::diagonal(int i) const
+{
+    double diag = base_->diagonal(i);
+    if (slot_[i] >= 0)
+    {
+        for (const auto &e : entries_[slot_[i]])
+        {
+            if (e.first == i)
+                diag += e.second;
+        }
+    }
+    if (uUsed_[i])
+    {
+        diag += lowRankDot(i, &V_[static_cast<size_t>(i) * rank_]);
+    }
+    return diag;
+}
+
+double UpdatedOperator::rowDot(int i, const double *x) const
+{
+    assertNotInSweep();
+    double sum = base_->rowDot(i, x) + sparseDot(i, x);
+    if (uUsed_[i])
+    {
+        sum += lowRankRowDot(i, x);
+    }
+    return sum;
+}
+
+void UpdatedOperator::rowDotBlock(int i, const double *X, int m, double *out) const
+{
+    assertNotInSweep();
+    base_->rowDotBlock(i, X, m, out);
+    sparseDotBlock(i, X, m, out);
+    if (uUsed_[i])
+    {
+        const int n = size();
+        const double *u = &U_[static_cast<size_t>(i) * rank_];
+        for (int j = 0; j < n; ++j)
+        {
+            if (!vUsed_[j])
+                continue;
+            const double *v = &V_[static_cast<size_t>(j) * rank_];
+            double a = 0.0;
+            for (int c = 0; c < rank_; ++c)
+            {
+                a += u[c] * v[c];
+            }
+            const double *x = X + static_cast<size_t>(j) * m;
+            for (int q = 0; q < m; ++q)
+            {
+                out[q] += a * x[q];
+            }
+        }
+    }
+}
+
+void UpdatedOperator::copyRow(int i, double *row) const
+{
+    base_->copyRow(i, row);
+    if (slot_[i] >= 0)
+    {
+        for (const auto &e : entries_[slot_[i]])
+        {
+            row[e.first] += e.second;
+        }
+    }
+    if (uUsed_[i])
+    {
+        const int n = size();
+        for (int j = 0; j < n; ++j)
+        {
+            if (vUsed_[j])
+                row[j] += lowRankDot(i, &V_[static_cast<size_t>(j) * rank_]);
+        }
+    }
+}
+
+void UpdatedOperator::apply(const double *x, double *y) const
+{
+    base_->apply(x, y);
+    if (!modified())
+    {
+        return;
+    }
+
+    const int n = size();
+    std::vector<double> w(rank_);
+    projectV(x, w.data());
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        if (uUsed_[i])
+            y[i] += lowRankDot(i, w.data());
+        if (slot_[i] >= 0)
+            y[i] += sparseDot(i, x);
+    }
+}
+
+void UpdatedOperator::applyBlock(const double *X, double *Y, int m) const
+{
+    base_->applyBlock(X, Y, m);
+    if (!modified())
+    {
+        return;
+    }
+
+    // W = VᵀX 为 rank×m，之后每行加上 U[i,:] W
+    const int n = size();
+    std::vector<double> W(static_cast<size_t>(rank_) * m);
+    projectVBlock(X, m, W.data());
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        double *y = Y + static_cast<size_t>(i) * m;
+        if (uUsed_[i])
+            lowRankDotBlock(i, W.data(), m, y);
+        sparseDotBlock(i, X, m, y);
+    }
+}
+
+double UpdatedOperator::sorSweep(int begin, int end, const double *b, const double *diag, double omega,
+                                 double *x) const
+{
+    if (!modified())
+    {
+        return base_->sorSweep(begin, end, b, diag, omega, x);
+    }
+
+    // w = Vᵀx 随 x 的更新同步修正。V 该行为零且没有稀疏增量的行不改变 w，
+    // 连续的这类行把 U[i,:] w 并入右端项后交给 base 的扫描内核；其余行逐行更新
+    std::vector<double> w(rank_);
+    projectV(x, w.data());
+    std::vector<double> rhs(end);
+    double maxDiff = 0.0;
+
+    int i = begin;
+    while (i < end)
+    {
+        if (vUsed_[i] || slot_[i] >= 0)
+        {
+            const double sum = base_->rowDot(i, x) + sparseDot(i, x) +
+                               (uUsed_[i] ? lowRankDot(i, w.data()) : 0.0);
+            const double delta = omega * (b[i] - sum) / diag[i];
+            x[i] += delta;
+            maxDiff = std::max(maxDiff, std::abs(delta));
+            if (vUsed_[i])
+            {
+                const double *v = &V_[static_cast<size_t>(i) * rank_];
+                for (int c = 0; c < rank_; ++c)
+                {
+                    w[c] += delta * v[c];
+                }
+            }
+            ++i;
+            continue;
+        }
+
+        int j = i;
+        for (; j < end && !vUsed_[j] && slot_[j] < 0; ++j)
+        {
+            rhs[j] = uUsed_[j] ? b[j] - lowRankDot(j, w.data()) : b[j];
+        }
+        maxDiff = std::max(maxDiff, base_->sorSweep(i, j, rhs.data(), diag, omega, x));
+        i = j;
+    }
+    return maxDiff;
+}
+
+void UpdatedOperator::sorSweepBlock(int begin, int end, const double *B, const double *diag, double omega,
+                                    double *X, int m, double *diff) const
+{
+    if (!modified())
+    {
+        base_->sorSweepBlock(begin, end, B, diag, omega, X, m, diff);
+        return;
+    }
+
+    // 与 sorSweep 相同，只是 w 换成 rank×m 的 W = VᵀX，逐列随 X 的更新同步修正
+    std::vector<double> W(static_cast<size_t>(rank_) * m);
+    projectVBlock(X, m, W.data());
+    std::vector<double> rhs(static_cast<size_t>(end) * m);
+    std::vector<double> acc(m);
+
+    int i = begin;
+    while (i < end)
+    {
+        if (vUsed_[i] || slot_[i] >= 0)
+        {
+            base_->rowDotBlock(i, X, m, acc.data());
+            sparseDotBlock(i, X, m, acc.data());
+            if (uUsed_[i])
+                lowRankDotBlock(i, W.data(), m, acc.data());
+
+            const size_t base = static_cast<size_t>(i) * m;
+            for (int q = 0; q < m; ++q)
+            {
+                const double delta = omega * (B[base + q] - acc[q]) / diag[i];
+                X[base + q] += delta;
+                diff[q] = std::max(diff[q], std::abs(delta));
+                acc[q] = delta;
+            }
+            if (vUsed_[i])
+            {
+                const double *v = &V_[static_cast<size_t>(i) * rank_];
+                for (int c = 0; c < rank_; ++c)
+                {
+                    for (int q = 0; q < m; ++q)
+                    {
+                        W[static_cast<size_t>(c) * m + q] += v[c] * acc[q];
+                    }
+                }
+            }
+            ++i;
+            continue;
+        }
+
+        int j = i;
+        for (; j < end && !vUsed_[j] && slot_[j] < 0; ++j)
+        {
+            double *r = &rhs[static_cast<size_t>(j) * m];
+            const double *b = B + static_cast<size_t>(j) * m;
+            std::fill(r, r + m, 0.0);
+            if (uUsed_[j])
+                lowRankDotBlock(j, W.data(), m, r);
+            for (int q = 0; q < m; ++q)
+            {
+                r[q] = b[q] - r[q];
+            }
+        }
+        base_->sorSweepBlock(i, j, rhs.data(), diag, omega, X, m, diff);
+        i = j;
+    }
+}
+
+double UpdatedOperator::jacobiSweep(int begin, int end, const double *b, const double *diag,
+                                    const double *x, double *xNew) const
+{
+    if (!modified())
+    {
+        return base_->jacobiSweep(begin, end, b, diag, x, xNew);
+    }
+
+    // 修改部分只依赖旧的 x，并入右端项后交给 base 的内核
+    std::vector<double> w(rank_);
+    projectV(x, w.data());
+    std::vector<double> rhs(end);
+#pragma omp parallel for schedule(static)
+    for (int i = begin; i < end; ++i)
+    {
+        double extra = sparseDot(i, x);
+        if (uUsed_[i])
+            extra += lowRankDot(i, w.data());
+        rhs[i] = b[i] - extra;
+    }
+    return base_->jacobiSweep(begin, end, rhs.data(), diag, x, xNew);
+}
+
+double UpdatedOperator::matrixBytes() const
+{
+    return base_->matrixBytes() + 12.0 * sparseCount_ + 16.0 * size() * rank_;
+}
+
+double UpdatedOperator::applyFlops() const
+{
+    return base_->applyFlops() + 2.0 * sparseCount_ + 4.0 * size() * rank_;
+}
@@ -0,0 +1,377 @@
+#include "../../include/solvers/batched_solver.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    const int W = BatchedSolver::kLanes;
+
+    // 一组 W 个方程组的工作区，最内层下标为通道号，按通道的循环可直接向量化
+    template <int N>
+    struct Block
+    {
+        double a[N][N][W];
+        double b[N][W];
+        double singular[W]; // 1.0 表示奇异
+    };
+
+    // 不足 W 个的尾组用单位矩阵补齐，保证补齐的通道不会被判为奇异
+    template <int N>
+    void loadAoS(Block<N> &blk, const double *A, const double *b, int first, int lanes)
+    {
+        for (int l = 0; l < W; ++l)
+        {
+            const bool real = l < lanes;
+            const double *As = A + static_cast<size_t>(first + l) * N * N;
+            const double *bs = b + static_cast<size_t>(first + l) * N;
+            for (int i = 0; i < N; ++i)
+            {
+                for (int j = 0; j < N; ++j)
+                {
+                    blk.a[i][j][l] = real ? As[i * N + j] : (i == j ? 1.0 : 0.0);
+                }
+                blk.b[i][l] = real ? bs[i] : 0.0;
+            }
+            blk.singular[l] = 0.0;
+        }
+    }
+
+    template <int N>
+    void loadSoA(Block<N> &blk, const double *A, const double *b, int first, int lanes, int count)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            for (int j = 0; j < N; ++j)
+            {
+                const double *src = A + static_cast<size_t>(i * N + j) * count + first;
+                for (int l = 0; l < W; ++l)
+                {
+                    blk.a[i][j][l] = l < lanes ? src[l] : (i == j ? 1.0 : 0.0);
+                }
+            }
+            const double *src = b + static_cast<size_t>(i) * count + first;
+            for (int l = 0; l < W; ++l)
+            {
+                blk.b[i][l] = l < lanes ? src[l] : 0.0;
+            }
+        }
+        std::fill(blk.singular, blk.singular + W, 0.0);
+    }
+
+    // 结果在 blk.b 中；奇异方程组的解置 0，返回奇异个数
+    template <int N>
+    int storeAoS(const Block<N> &blk, double *x, unsigned char *status, int first, int lanes)
+    {
+        int singular = 0;
+        for (int l = 0; l < lanes; ++l)
+        {
+            const bool bad = blk.singular[l] != 0.0;
+            double *xs = x + static_cast<size_t>(first + l) * N;
+            for (int i = 0; i < N; ++i)
+            {
+                xs[i] = bad ? 0.0 : blk.b[i][l];
+            }
+            if (status)
+                status[first + l] = bad ? 1 : 0;
+            singular += bad ? 1 : 0;
+        }
+        return singular;
+    }
+
+    template <int N>
+    int storeSoA(const Block<N> &blk, double *x, unsigned char *status, int first, int lanes, int count)
+    {
+        int singular = 0;
+        for (int i = 0; i < N; ++i)
+        {
+            double *dst = x + static_cast<size_t>(i) * count + first;
+            for (int l = 0; l < lanes; ++l)
+            {
+                dst[l] = blk.singular[l] != 0.0 ? 0.0 : blk.b[i][l];
+            }
+        }
+        for (int l = 0; l < lanes; ++l)
+        {
+            const bool bad = blk.singular[l] != 0.0;
+            if (status)
+                status[first + l] = bad ? 1 : 0;
+            singular += bad ? 1 : 0;
+        }
+        return singular;
+    }
+
+    // 各通道 A 的最大元素绝对值，奇异判据按它缩放，与 A 的整体缩放无关
+    template <int N>
+    void laneScale(const Block<N> &blk, double *scale)
+    {
+#pragma omp simd
+        for (int l = 0; l < W; ++l)
+        {
+            scale[l] = 0.0;
+        }
+        for (int i = 0; i < N; ++i)
+        {
+            for (int j = 0; j < N; ++j)
+            {
+#pragma omp simd
+                for (int l = 0; l < W; ++l)
+                {
+                    scale[l] = std::max(scale[l], std::abs(blk.a[i][j][l]));
+                }
+            }
+        }
+    }
+
+    // 列主元 LU 并同时消去右端项，再回代；N 为编译期常量，各层循环可完全展开
+    // 各通道的主元行不同，选主元与行交换都写成按通道的掩码运算，避免分支破坏向量化
+    template <int N>
+    void solveBlock(Block<N> &blk, double tol)
+    {
+        auto &a = blk.a;
+        auto &b = blk.b;
+
+        // 主元不超过 tol·max|a_ij| 视为奇异
+        double limit[W];
+        laneScale(blk, limit);
+#pragma omp simd
+        for (int l = 0; l < W; ++l)
+        {
+            limit[l] *= tol;
+        }
+
+        for (int k = 0; k < N; ++k)
+        {
+            double best[W];
+            double pivotRow[W];
+#pragma omp simd
+            for (int l = 0; l < W; ++l)
+            {
+                best[l] = std::abs(a[k][k][l]);
+                pivotRow[l] = k;
+            }
+            for (int i = k + 1; i < N; ++i)
+            {
+#pragma omp simd
+                for (int l = 0; l < W; ++l)
+                {
+                    const double v = std::abs(a[i][k][l]);
+                    const double larger = v > best[l] ? 1.0 : 0.0;
+                    best[l] = std::max(v, best[l]);
+                    pivotRow[l] += larger * (i - pivotRow[l]);
+                }
+            }
+#pragma omp simd
+            for (int l = 0; l < W; ++l)
+            {
+                blk.singular[l] = std::max(blk.singular[l], best[l] <= limit[l] ? 1.0 : 0.0);
+            }
+
+            for (int i = k + 1; i < N; ++i)
+            {
+                for (int j = k; j < N; ++j)
+                {
+#pragma omp simd
+                    for (int l = 0; l < W; ++l)
+                    {
+                        const double swap = pivotRow[l] == i ? 1.0 : 0.0;
+                        const double d = swap * (a[i][j][l] - a[k][j][l]);
+                        a[k][j][l] += d;
+                        a[i][j][l] -= d;
+                    }
+                }
+#pragma omp simd
+                for (int l = 0; l < W; ++l)
+                {
+                    const double swap = pivotRow[l] == i ? 1.0 : 0.0;
+                    const double d = swap * (b[i][l] - b[k][l]);
+                    b[k][l] += d;
+                    b[i][l] -= d;
+                }
+            }
+
+            // 奇异通道的主元可能为 0，用 1 代替以免产生 inf/NaN，其结果最终被丢弃
+            double inv[W];
+#pragma omp simd
+            for (int l = 0; l < W; ++l)
+            {
+                const double pivot = a[k][k][l];
+                inv[l] = 1.0 / (pivot + blk.singular[l] * (1.0 - pivot));
+                a[k][k][l] = inv[l];
+            }
+            for (int i = k + 1; i < N; ++i)
+            {
+                double factor[W];
+#pragma omp simd
+                for (int l = 0; l < W; ++l)
+                {
+                    factor[l] = a[i][k][l] * inv[l];
+                    b[i][l] -= factor[l] * b[k][l];
+                }
+                for (int j = k + 1; j < N; ++j)
+                {
+#pragma omp simd
+                    for (int l = 0; l < W; ++l)
+                    {
+                        a[i][j][l] -= factor[l] * a[k][j][l];
+                    }
+                }
+            }
+        }
+
+        // 回代，对角位置已存放主元的倒数
+        for (int i = N - 1; i >= 0; --i)
+        {
+            for (int j = i + 1; j < N; ++j)
+            {
+#pragma omp simd
+                for (int l = 0; l < W; ++l)
+                {
+                    b[i][l] -= a[i][j][l] * b[j][l];
+                }
+            }
+#pragma omp simd
+            for (int l = 0; l < W; ++l)
+            {
+                b[i][l] *= a[i][i][l];
+            }
+        }
+    }
+
+    // n ≤ 3 时 Cramer 法则比消元的指令更少且没有行交换
+    // 行列式按 max|a_ij|ⁿ 缩放后与 tol 比较，和 LU 路径的主元判据一样不受 A 整体缩放影响
+    template <>
+    void solveBlock<1>(Block<1> &blk, double tol)
+    {
+        (void)tol;
+#pragma omp simd
+        for (int l = 0; l < W; ++l)
+        {
+            const double det = blk.a[0][0][l];
+            const bool bad = det == 0.0; // 1×1 时相对判据退化为 a == 0
+            blk.singular[l] = bad ? 1.0 : 0.0;
+            blk.b[0][l] = blk.b[0][l] / (bad ? 1.0 : det);
+        }
+    }
+
+    template <>
+    void solveBlock<2>(Block<2> &blk, double tol)
+    {
+        auto &a = blk.a;
+        auto &b = blk.b;
+        double scale[W];
+        laneScale(blk, scale);
+#pragma omp simd
+        for (int l = 0; l < W; ++l)
+        {
+            const double det = a[0][0][l] * a[1][1][l] - a[0][1][l] * a[1][0][l];
+            const bool bad = std::abs(det) <= tol * scale[l] * scale[l];
+            const double inv = 1.0 / (bad ? 1.0 : det);
+            const double x0 = (b[0][l] * a[1][1][l] - a[0][1][l] * b[1][l]) * inv;
+            const double x1 = (a[0][0][l] * b[1][l] - b[0][l] * a[1][0][l]) * inv;
+            blk.singular[l] = bad ? 1.0 : 0.0;
+            b[0][l] = x0;
+            b[1][l] = x1;
+        }
+    }
+
+    template <>
+    void solveBlock<3>(Block<3> &blk, double tol)
+    {
+        auto &a = blk.a;
+        auto &b = blk.b;
+        double scale[W];
+        laneScale(blk, scale);
+#pragma omp simd
+        for (int l = 0; l < W; ++l)
+        {
+            // 第一行的代数余子式
+            const double c00 = a[1][1][l] * a[2][2][l] - a[1][2][l] * a[2][1][l];
+            const double c01 = a[1][2][l] * a[2][0][l] - a[1][0][l] * a[2][2][l];
+            const double c02 = a[1][0][l] * a[2][1][l] - a[1][1][l] * a[2][0][l];
+            const double det = a[0][0][l] * c00 + a[0][1][l] * c01 + a[0][2][l] * c02;
+            const bool bad = std::abs(det) <= tol * scale[l] * scale[l] * scale[l];
+            const double inv = 1.0 / (bad ? 1.0 : det);
+
+            // x = adj(A) b / det
+            const double x0 = (c00 * b[0][l] +
+                               (a[0][2][l] * a[2][1][l] - a[0][1][l] * a[2][2][l]) * b[1][l] +
+                               (a[0][1][l] * a[1][2][l] - a[0][2][l] * a[1][1][l]) * b[2][l]) * inv;
+            const double x1 = (c01 * b[0][l] +
+                               (a[0][0][l] * a[2][2][l] - a[0][2][l] * a[2][0][l]) * b[1][l] +
+                               (a[0][2][l] * a[1][0][l] - a[0][0][l] * a[1][2][l]) * b[2][l]) * inv;
+            const double x2 = (c02 * b[0][l] +
+                               (a[0][1][l] * a[2][0][l] - a[0][0][l] * a[2][1][l]) * b[1][l] +
+                               (a[0][0][l] * a[1][1][l] - a[0][1][l] * a[1][0][l]) * b[2][l]) * inv;
+            blk.singular[l] = bad ? 1.0 : 0.0;
+            b[0][l] = x0;
+            b[1][l] = x1;
+            b[2][l] = x2;
+        }
+    }
+
+    template <int N, bool SoA>
+    int solveBatch(int count, const double *A, const double *b, double *x,
+                   unsigned char *status, double tol)
+    {
+        const int blocks = (count + W - 1) / W;
+        int singular = 0;
+
+#pragma omp parallel for schedule(static) reduction(+ : singular) if (blocks > 64)
+        for (int g = 0; g < blocks; ++g)
+        {
+            Block<N> blk;
+            const int first = g * W;
+            const int lanes = std::min(W, count - first);
+            if (SoA)
+            {
+                loadSoA(blk, A, b, first, lanes, count);
+                solveBlock(blk, tol);
+                singular += storeSoA(blk, x, status, first, lanes, count);
+            }
+            else
+            {
+                loadAoS(blk, A, b, first, lanes);
+                solveBlock(blk, tol);
+                singular += storeAoS(blk, x, status, first, lanes);
+            }
+        }
+        return singular;
+    }
+
+    typedef int (*BatchFn)(int, const double *, const double *, double *, unsigned char *, double);
+
+    // 按 n 分派到对应的内核，下标 0 不用
+    const BatchFn kAoS[BatchedSolver::kMaxSize + 1] = {
+        nullptr,
+        solveBatch<1, false>, solveBatch<2, false>, solveBatch<3, false>, solveBatch<4, false>,
+        solveBatch<5, false>, solveBatch<6, false>, solveBatch<7, false>, solveBatch<8, false>,
+        solveBatch<9, false>, solveBatch<10, false>, solveBatch<11, false>, solveBatch<12, false>,
+        solveBatch<13, false>, solveBatch<14, false>, solveBatch<15, false>, solveBatch<16, false>};
+
+    const BatchFn kSoA[BatchedSolver::kMaxSize + 1] = {
+        nullptr,
+        solveBatch<1, true>, solveBatch<2, true>, solveBatch<3, true>, solveBatch<4, true>,
+        solveBatch<5, true>, solveBatch<6, true>, solveBatch<7, true>, solveBatch<8, true>,
+        solveBatch<9, true>, solveBatch<10, true>, solveBatch<11, true>, solveBatch<12, true>,
+        solveBatch<13, true>, solveBatch<14, true>, solveBatch<15, true>, solveBatch<16, true>};
+}
+
+int BatchedSolver::solve(int n, int count, const double *A, const double *b, double *x,
+                         unsigned char *status) const
+{
+    if (n < 1 || n > kMaxSize || count < 0)
+    {
+        return -1;
+    }
+    return kAoS[n](count, A, b, x, status, pivotTolerance_);
+}
+
+int BatchedSolver::solveSoA(int n, int count, const double *A, const double *b, double *x,
+                            unsigned char *status) const
+{
+    if (n < 1 || n > kMaxSize || count < 0)
+    {
+        return -1;
+    }
+    return kSoA[n](count, A, b, x, status, pivotTolerance_);
+}
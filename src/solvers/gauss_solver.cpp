@@ -1,27 +1,74 @@
 #include "../../include/solvers/gauss_solver.h"
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <numeric>
+#include <sstream>
 
-bool GaussSolver::solve(std::vector<double> &x)
+std::string GaussSolver::cacheSettings() const
+{
+    // 容差决定主元是否被判为奇异，按精确值参与哈希
+    std::ostringstream out;
+    out << "gauss-lu-partial-pivot tol=" << std::hexfloat << tolerance_;
+    return out.str();
+}
+
+bool GaussSolver::factorize()
 {
-    const int n = A_.size();
-    // 创建增广矩阵 [A|b]
-    std::vector<std::vector<double> > Ab = A_;
+    const int n = op_->size();
+    factorized_ = false;
+    rank_ = 0;
+    cached_.reset();
+    stored_ = false;
+
+    FactorCache::Key key;
+    if (cache_)
+    {
+        // 哈希需逐行展开一遍算子，相比 O(n³) 的消元可以忽略
+        key = FactorCache::hash(*op_, cacheSettings());
+        cached_ = cache_->load(key, n);
+        if (cached_)
+        {
+            work_.bytes = op_->matrixBytes();
+            work_.flops = 0.0;
+            std::vector<double>().swap(lu_);
+            std::vector<int>().swap(perm_);
+            luData_ = cached_->lu();
+            permData_ = cached_->perm();
+            factorized_ = true;
+            return true;
+        }
+    }
+
+    // 消元第 k 步读写 (n-k)^2 个元素，共约 n^3/3 次乘加
+    const double dn = n;
+    work_.bytes = 16.0 * dn * dn * dn / 3.0;
+    work_.flops = 2.0 * dn * dn * dn / 3.0;
+    lu_.resize(static_cast<size_t>(n) * n);
+    perm_.resize(n);
+    std::iota(perm_.begin(), perm_.end(), 0);
+
+    // 逐行展开算子，显式矩阵与矩阵自由算子都可分解
+#pragma omp parallel for schedule(static)
     for (int i = 0; i < n; ++i)
     {
-        Ab[i].push_back(b_[i]);
+        op_->copyRow(i, &lu_[static_cast<size_t>(i) * n]);
     }
 
     // 前向消元
     for (int k = 0; k < n; ++k)
     {
+        double *rowK = &lu_[static_cast<size_t>(k) * n];
+
         // 选主元
         int maxRow = k;
-        double maxVal = std::abs(Ab[k][k]);
+        double maxVal = std::abs(rowK[k]);
         for (int i = k + 1; i < n; ++i)
         {
-            if (std::abs(Ab[i][k]) > maxVal)
+            double val = std::abs(lu_[static_cast<size_t>(i) * n + k]);
+            if (val > maxVal)
             {
-                maxVal = std::abs(Ab[i][k]);
+                maxVal = val;
                 maxRow = i;
             }
         }
@@ -34,31 +81,293 @@ bool GaussSolver::solve(std::vector<double> &x)
         // 交换行
         if (maxRow != k)
         {
-            std::swap(Ab[k], Ab[maxRow]);
+            std::swap_ranges(rowK, rowK + n, &lu_[static_cast<size_t>(maxRow) * n]);
+            std::swap(perm_[k], perm_[maxRow]);
         }
 
-        // 消元
+        // 消元，消元因子存入下三角
+        const double pivot = rowK[k];
+#pragma omp parallel for schedule(static) if (n - k > 256)
         for (int i = k + 1; i < n; ++i)
         {
-            double factor = Ab[i][k] / Ab[k][k];
-            for (int j = k; j <= n; ++j)
+            double *rowI = &lu_[static_cast<size_t>(i) * n];
+            double factor = rowI[k] / pivot;
+            rowI[k] = factor;
+            for (int j = k + 1; j < n; ++j)
             {
-                Ab[i][j] -= factor * Ab[k][j];
+                rowI[j] -= factor * rowK[j];
             }
         }
     }
 
-    // 回代
-    x.resize(n);
+    luData_ = lu_.data();
+    permData_ = perm_.data();
+    factorized_ = true;
+    if (cache_)
+    {
+        stored_ = cache_->store(key, n, perm_.data(), lu_.data());
+    }
+    return true;
+}
+
+void GaussSolver::substitute(const double *rhs, double *x) const
+{
+    const int n = op_->size();
+
+    // 前代 Ly = Pb
+    for (int i = 0; i < n; ++i)
+    {
+        const double *row = luData_ + static_cast<size_t>(i) * n;
+        double sum = rhs[permData_[i]];
+        for (int j = 0; j < i; ++j)
+        {
+            sum -= row[j] * x[j];
+        }
+        x[i] = sum;
+    }
+
+    // 回代 Ux = y
     for (int i = n - 1; i >= 0; --i)
     {
+        const double *row = luData_ + static_cast<size_t>(i) * n;
         double sum = 0.0;
         for (int j = i + 1; j < n; ++j)
         {
-            sum += Ab[i][j] * x[j];
+            sum += row[j] * x[j];
+        }
+        x[i] = (x[i] - sum) / row[i];
+    }
+}
+
+void GaussSolver::lowRankUpdate(const std::vector<double> &U, const std::vector<double> &V, int k)
+{
+    if (!factorized_)
+    {
+        return; // 尚未分解，下次求解直接分解更新后的 A
+    }
+
+    // 秩累计到 n/8 以上时，每次求解的 O(n·rank) 修正与更新的 O(n²·k) 开销不再划算
+    const int n = op_->size();
+    const int rank = rank_ + k;
+    if (rank > std::max(1, n / 8))
+    {
+        invalidate();
+        return;
+    }
+
+    // 在 Z_、V_ 末尾追加 k 列：Z 的新列为 A0⁻¹ U 的各列，各列回代互相独立
+    std::vector<double> Z(static_cast<size_t>(n) * rank);
+    std::vector<double> Vn(static_cast<size_t>(n) * rank);
+    for (int i = 0; i < n; ++i)
+    {
+        for (int c = 0; c < rank_; ++c)
+        {
+            Z[static_cast<size_t>(i) * rank + c] = Z_[static_cast<size_t>(i) * rank_ + c];
+            Vn[static_cast<size_t>(i) * rank + c] = V_[static_cast<size_t>(i) * rank_ + c];
+        }
+        for (int c = 0; c < k; ++c)
+        {
+            Vn[static_cast<size_t>(i) * rank + rank_ + c] = V[static_cast<size_t>(i) * k + c];
+        }
+    }
+
+#pragma omp parallel
+    {
+        std::vector<double> u(n);
+        std::vector<double> z(n);
+#pragma omp for schedule(dynamic)
+        for (int c = 0; c < k; ++c)
+        {
+            for (int i = 0; i < n; ++i)
+            {
+                u[i] = U[static_cast<size_t>(i) * k + c];
+            }
+            substitute(u.data(), z.data());
+            for (int i = 0; i < n; ++i)
+            {
+                Z[static_cast<size_t>(i) * rank + rank_ + c] = z[i];
+            }
+        }
+    }
+
+    Z_.swap(Z);
+    V_.swap(Vn);
+    rank_ = rank;
+    if (!factorizeCapacitance())
+    {
+        invalidate(); // 修正矩阵奇异，改为重新分解 (A 本身奇异时由分解报告)
+    }
+}
+
+void GaussSolver::entriesUpdate(const std::vector<int> &rows, const std::vector<int> &cols,
+                                const std::vector<double> &values)
+{
+    if (!factorized_)
+    {
+        return;
+    }
+
+    std::map<int, int> slots;
+    for (int row : rows)
+    {
+        slots.emplace(row, static_cast<int>(slots.size()));
+    }
+    const int n = op_->size();
+    const int k = slots.size();
+    if (rank_ + k > std::max(1, n / 8))
+    {
+        invalidate(); // 与 lowRankUpdate 相同的上限，超出时不必展开 U、V
+        return;
+    }
+
+    std::vector<double> U(static_cast<size_t>(n) * k, 0.0);
+    std::vector<double> V(static_cast<size_t>(n) * k, 0.0);
+    for (const auto &slot : slots)
+    {
+        U[static_cast<size_t>(slot.first) * k + slot.second] = 1.0;
+    }
+    for (size_t t = 0; t < rows.size(); ++t)
+    {
+        V[static_cast<size_t>(cols[t]) * k + slots[rows[t]]] += values[t];
+    }
+    lowRankUpdate(U, V, k);
+}
+
+bool GaussSolver::factorizeCapacitance()
+{
+    const int n = op_->size();
+    const int r = rank_;
+    cap_.assign(static_cast<size_t>(r) * r, 0.0);
+    capPerm_.resize(r);
+    std::iota(capPerm_.begin(), capPerm_.end(), 0);
+
+    // cap = I + VᵀZ
+    for (int i = 0; i < n; ++i)
+    {
+        const double *v = &V_[static_cast<size_t>(i) * r];
+        const double *z = &Z_[static_cast<size_t>(i) * r];
+        for (int a = 0; a < r; ++a)
+        {
+            for (int c = 0; c < r; ++c)
+            {
+                cap_[static_cast<size_t>(a) * r + c] += v[a] * z[c];
+            }
+        }
+    }
+    for (int a = 0; a < r; ++a)
+    {
+        cap_[static_cast<size_t>(a) * r + a] += 1.0;
+    }
+
+    // 与 factorize 相同的列主元消元
+    for (int k = 0; k < r; ++k)
+    {
+        double *rowK = &cap_[static_cast<size_t>(k) * r];
+        int maxRow = k;
+        double maxVal = std::abs(rowK[k]);
+        for (int i = k + 1; i < r; ++i)
+        {
+            double val = std::abs(cap_[static_cast<size_t>(i) * r + k]);
+            if (val > maxVal)
+            {
+                maxVal = val;
+                maxRow = i;
+            }
+        }
+        if (maxVal < tolerance_)
+        {
+            return false;
+        }
+        if (maxRow != k)
+        {
+            std::swap_ranges(rowK, rowK + r, &cap_[static_cast<size_t>(maxRow) * r]);
+            std::swap(capPerm_[k], capPerm_[maxRow]);
+        }
+        for (int i = k + 1; i < r; ++i)
+        {
+            double *rowI = &cap_[static_cast<size_t>(i) * r];
+            double factor = rowI[k] / rowK[k];
+            rowI[k] = factor;
+            for (int j = k + 1; j < r; ++j)
+            {
+                rowI[j] -= factor * rowK[j];
+            }
+        }
+    }
+    return true;
+}
+
+bool GaussSolver::solve(std::vector<double> &x)
+{
+    iterations_ = 0;
+    work_ = WorkEstimate();
+    singular_ = false;
+    if (!factorized_ && !factorize())
+    {
+        singular_ = true;
+        return false;
+    }
+
+    const int n = op_->size();
+    x.resize(n);
+
+    // 前代与回代各读一半 LU
+    work_.bytes += 8.0 * n * n;
+    work_.flops += 2.0 * n * n;
+
+    substitute(b_.data(), x.data());
+    if (rank_ == 0)
+    {
+        return true;
+    }
+
+    // Woodbury: x = y - Z (I + VᵀZ)⁻¹ Vᵀy，其中 y = A0⁻¹b
+    const int r = rank_;
+    work_.bytes += 16.0 * n * r;
+    work_.flops += 4.0 * n * r;
+    std::vector<double> w(r, 0.0);
+    for (int i = 0; i < n; ++i)
+    {
+        const double *v = &V_[static_cast<size_t>(i) * r];
+        for (int c = 0; c < r; ++c)
+        {
+            w[c] += v[c] * x[i];
+        }
+    }
+
+    std::vector<double> t(r);
+    for (int a = 0; a < r; ++a)
+    {
+        const double *row = &cap_[static_cast<size_t>(a) * r];
+        double sum = w[capPerm_[a]];
+        for (int c = 0; c < a; ++c)
+        {
+            sum -= row[c] * t[c];
+        }
+        t[a] = sum;
+    }
+    for (int a = r - 1; a >= 0; --a)
+    {
+        const double *row = &cap_[static_cast<size_t>(a) * r];
+        double sum = 0.0;
+        for (int c = a + 1; c < r; ++c)
+        {
+            sum += row[c] * t[c];
+        }
+        t[a] = (t[a] - sum) / row[a];
+    }
+
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i)
+    {
+        const double *z = &Z_[static_cast<size_t>(i) * r];
+        double sum = 0.0;
+        for (int c = 0; c < r; ++c)
+        {
+            sum += z[c] * t[c];
         }
-        x[i] = (Ab[i][n] - sum) / Ab[i][i];
+        x[i] -= sum;
     }
 
     return true;
-}
\ No newline at end of file
+}
@@ -1,52 +1,170 @@
 #include "../../include/solvers/jacobi_solver.h"
+#include <algorithm>
 #include <cmath>
+#include <numeric>
 
 bool JacobiSolver::solve(std::vector<double> &x)
 {
-    const int n = A_.size();
-    std::vector<double> x_new(n);
+    const LinearOperator &A = *op_;
+    const int n = A.size();
+    initialGuess(x, n);
+    iterations_ = 0;
+    work_ = WorkEstimate();
 
     // 检查对角线元素是否为0
-    for (int i = 0; i < n; ++i)
+    NumaVector diag;
+    if (!loadDiagonal(diag))
     {
-        if (std::abs(A_[i][i]) < 1e-10)
+        return false; // 对角线元素太接近0，无法求解
+    }
+
+    // 工作向量按与迭代相同的行划分首次写入
+    NumaVector x_cur(n);
+    NumaVector x_new(n);
+    NumaVector y(n);
+    firstTouchCopy(x_cur.data(), x.data(), n);
+    firstTouchFill(x_new.data(), 0.0, n);
+    firstTouchFill(y.data(), 0.0, n);
+
+    bool converged = false;
+
+    // 带状矩阵按组做时间分块，行块在缓存中连续推进多层，组末检查收敛
+    const int bandwidth = blockSweeps_ > 1 ? A.bandwidth() : -1;
+    tileRows_ = temporalTileRows(bandwidth, blockSweeps_, 4, threadCount());
+    for (int iter = 0; tileRows_ > 0 && iter < maxIterations_ && !converged;)
+    {
+        const int levels = std::min(blockSweeps_, maxIterations_ - iter);
+        // 第 t 层读 buf[t % 2]、写 buf[(t + 1) % 2]，只在最后一层统计增量
+        double *buf[2] = {x_cur.data(), x_new.data()};
+        double diff = 0.0;
+        wavefront(n, bandwidth, levels, tileRows_, [&](int t, int begin, int end) {
+            const double d = A.jacobiSweep(begin, end, b_.data(), diag.data(), buf[t % 2], buf[(t + 1) % 2]);
+            if (t == levels - 1)
+                diff = std::max(diff, d);
+        });
+
+        if (levels % 2 == 1)
+        {
+            x_cur.swap(x_new);
+        }
+        iter += levels;
+        iterations_ = iter;
+        // 读 x、b、对角元，写 x_new
+        addTemporalWork(levels, 4, 3.0);
+
+        if (diff < tolerance_)
         {
-            return false; // 对角线元素太接近0，无法求解
+            converged = true;
         }
     }
 
-    // 迭代求解
-    for (int iter = 0; iter < maxIterations_; ++iter)
+    // 逐次扫描
+    for (int iter = 0; tileRows_ == 0 && iter < maxIterations_ && !converged; ++iter)
     {
-        // 计算新的x值
-        for (int i = 0; i < n; ++i)
+        // y = A x，x_new = x + D^{-1}(b - A x)
+        A.apply(x_cur.data(), y.data());
+
+        double diff = 0.0;
+
+#pragma omp parallel
         {
-            double sum = 0.0;
-            for (int j = 0; j < n; ++j)
+            double localDiff = 0.0;
+
+            // 计算新的x值
+#pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
             {
-                if (j != i)
-                {
-                    sum += A_[i][j] * x[j];
-                }
+                double delta = (b_[i] - y[i]) / diag[i];
+                x_new[i] = x_cur[i] + delta;
+                localDiff = std::max(localDiff, std::abs(delta));
             }
-            x_new[i] = (b_[i] - sum) / A_[i][i];
-        }
 
-        // 检查收敛性
-        double diff = 0.0;
-        for (int i = 0; i < n; ++i)
-        {
-            diff = std::max(diff, std::abs(x_new[i] - x[i]));
+            // 检查收敛性
+#pragma omp critical
+            diff = std::max(diff, localDiff);
         }
 
         // 更新x值
-        x = x_new;
+        x_cur.swap(x_new);
+        iterations_ = iter + 1;
+        // 读 x、b、对角元、y 两次 (apply 写入后再读)，写 x_new
+        addSweepWork(1, 6, 3.0);
 
         if (diff < tolerance_)
         {
-            return true; // 收敛
+            converged = true; // 收敛
+        }
+    }
+
+    std::copy(x_cur.begin(), x_cur.end(), x.begin());
+    rememberSolution(x);
+    return converged; // 未收敛表示达到最大迭代次数
+}
+
+bool JacobiSolver::solveBlock(std::vector<double> &X)
+{
+    const LinearOperator &A = *op_;
+    const int n = A.size();
+    const int k = rhsCount_;
+    X.resize(static_cast<size_t>(n) * k, 0.0);
+    columnIterations_.assign(k, maxIterations_);
+    columnConverged_.assign(k, 0);
+    work_ = WorkEstimate();
+
+    NumaVector diag;
+    if (!loadDiagonal(diag))
+    {
+        columnIterations_.assign(k, 0);
+        return false;
+    }
+
+    // 工作块只保留尚未收敛的列，cols[q] 为第 q 个活动列的原始列号
+    std::vector<int> cols(k);
+    std::iota(cols.begin(), cols.end(), 0);
+    int m = k;
+
+    NumaVector W(X.size());
+    NumaVector W_new(X.size());
+    NumaVector Y(X.size());
+    NumaVector Bw(X.size());
+    firstTouchCopy(W.data(), X.data(), X.size());
+    firstTouchFill(W_new.data(), 0.0, X.size());
+    firstTouchFill(Y.data(), 0.0, X.size());
+    firstTouchCopy(Bw.data(), B_.data(), X.size());
+
+    for (int iter = 0; iter < maxIterations_ && m > 0; ++iter)
+    {
+        // 一次扫描 A 得到全部 m 个活动列的 A X
+        A.applyBlock(W.data(), Y.data(), m);
+
+        std::vector<double> diff(m, 0.0);
+
+#pragma omp parallel
+        {
+            std::vector<double> localDiff(m, 0.0);
+
+#pragma omp for schedule(static)
+            for (int i = 0; i < n; ++i)
+            {
+                const size_t base = static_cast<size_t>(i) * m;
+                for (int q = 0; q < m; ++q)
+                {
+                    double delta = (Bw[base + q] - Y[base + q]) / diag[i];
+                    W_new[base + q] = W[base + q] + delta;
+                    localDiff[q] = std::max(localDiff[q], std::abs(delta));
+                }
+            }
+
+#pragma omp critical
+            for (int q = 0; q < m; ++q)
+                diff[q] = std::max(diff[q], localDiff[q]);
         }
+
+        W.swap(W_new);
+        addSweepWork(m, 5, 3.0);
+        m = retireColumns(X, cols, diff, iter, W, Bw, n);
     }
 
-    return false; // 达到最大迭代次数仍未收敛
-}
\ No newline at end of file
+    storeColumns(X, cols, W, n);
+    return m == 0;
+}
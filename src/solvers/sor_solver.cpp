@@ -1,60 +1,125 @@
 #include "../../include/solvers/sor_solver.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <numeric>
 
 bool SORSolver::solve(std::vector<double> &x)
 {
-    const int n = A_.size();
-    std::vector<double> x_new(x);
+    const LinearOperator &A = *op_;
+    const int n = A.size();
+    initialGuess(x, n);
+    iterations_ = 0;
+    work_ = WorkEstimate();
 
     // 检查对角线元素是否为0
-    for (int i = 0; i < n; ++i)
+    NumaVector diag;
+    if (!loadDiagonal(diag))
     {
-        if (std::abs(A_[i][i]) < 1e-10)
-        {
+        if (verbose_)
             std::cout << "对角线元素太接近0，无法求解" << std::endl;
-            return false;
-        }
+        return false;
     }
 
-    // 迭代求解
-    for (int iter = 0; iter < maxIterations_; ++iter)
+    // 带状矩阵按组做时间分块：原地更新时各层的依赖由波前顺序保证，组末检查收敛
+    const int bandwidth = blockSweeps_ > 1 ? A.bandwidth() : -1;
+    tileRows_ = temporalTileRows(bandwidth, blockSweeps_, 3, 1);
+    for (int iter = 0; tileRows_ > 0 && iter < maxIterations_;)
     {
+        const int levels = std::min(blockSweeps_, maxIterations_ - iter);
         double maxDiff = 0.0;
+        wavefront(n, bandwidth, levels, tileRows_, [&](int t, int begin, int end) {
+            const double d = A.sorSweep(begin, end, b_.data(), diag.data(), omega_, x.data());
+            if (t == levels - 1)
+                maxDiff = std::max(maxDiff, d);
+        });
+        iter += levels;
+        iterations_ = iter;
+        // 读 x、b、对角元，写回 x
+        addTemporalWork(levels, 4, 4.0);
 
-        // 计算新的x值
-        for (int i = 0; i < n; ++i)
+        if (maxDiff < tolerance_)
         {
-            double sum1 = 0.0; // 已更新的元素之和
-            double sum2 = 0.0; // 未更新的元素之和
-
-            for (int j = 0; j < i; ++j)
-            {
-                sum1 += A_[i][j] * x_new[j];
-            }
-            for (int j = i + 1; j < n; ++j)
-            {
-                sum2 += A_[i][j] * x[j];
-            }
-
-            // SOR迭代公式
-            double x_old = x[i];
-            x_new[i] = (1 - omega_) * x_old +
-                       (omega_ / A_[i][i]) * (b_[i] - sum1 - sum2);
-
-            maxDiff = std::max(maxDiff, std::abs(x_new[i] - x_old));
+            if (verbose_)
+                std::cout << "迭代次数: " << iter << std::endl;
+            rememberSolution(x);
+            return true;
         }
+    }
+
+    // 逐次扫描
+    for (int iter = 0; tileRows_ == 0 && iter < maxIterations_; ++iter)
+    {
+        iterations_ = iter + 1;
+        // 读 x、b、对角元，写回 x
+        addSweepWork(1, 4, 4.0);
 
-        // 更新x值
-        x = x_new;
+        // 原地更新：第 i 行内积中 j < i 的部分已是本次迭代的新值
+        // SOR迭代公式 x_i += ω (b_i - (A x)_i) / a_ii
+        double maxDiff = A.sorSweep(0, n, b_.data(), diag.data(), omega_, x.data());
 
         if (maxDiff < tolerance_)
         {
-            std::cout << "迭代次数: " << iter + 1 << std::endl;
+            if (verbose_)
+                std::cout << "迭代次数: " << iter + 1 << std::endl;
+            rememberSolution(x);
             return true; // 收敛
         }
     }
 
-    std::cout << "达到最大迭代次数仍未收敛" << std::endl;
+    if (verbose_)
+        std::cout << "达到最大迭代次数仍未收敛" << std::endl;
+    rememberSolution(x);
     return false;
-}
\ No newline at end of file
+}
+
+bool SORSolver::solveBlock(std::vector<double> &X)
+{
+    const LinearOperator &A = *op_;
+    const int n = A.size();
+    const int k = rhsCount_;
+    X.resize(static_cast<size_t>(n) * k, 0.0);
+    columnIterations_.assign(k, maxIterations_);
+    columnConverged_.assign(k, 0);
+    work_ = WorkEstimate();
+
+    NumaVector diag;
+    if (!loadDiagonal(diag))
+    {
+        columnIterations_.assign(k, 0);
+        if (verbose_)
+            std::cout << "对角线元素太接近0，无法求解" << std::endl;
+        return false;
+    }
+
+    // 工作块只保留尚未收敛的列，cols[q] 为第 q 个活动列的原始列号
+    std::vector<int> cols(k);
+    std::iota(cols.begin(), cols.end(), 0);
+    int m = k;
+
+    NumaVector W(X.begin(), X.end());
+    NumaVector Bw(B_.begin(), B_.end());
+
+    for (int iter = 0; iter < maxIterations_ && m > 0; ++iter)
+    {
+        std::vector<double> diff(m, 0.0);
+        addSweepWork(m, 4, 4.0);
+
+        // 原地更新：j < i 读到的已是本次迭代的新值
+        A.sorSweepBlock(0, n, Bw.data(), diag.data(), omega_, W.data(), m, diff.data());
+
+        int remaining = retireColumns(X, cols, diff, iter, W, Bw, n);
+        if (verbose_ && remaining < m && !cols.empty())
+        {
+            std::cout << "迭代 " << iter + 1 << " 后剩余未收敛列数: " << remaining << std::endl;
+        }
+        m = remaining;
+    }
+
+    storeColumns(X, cols, W, n);
+    if (verbose_ && m > 0)
+    {
+        std::cout << "达到最大迭代次数仍有 " << m << " 列未收敛" << std::endl;
+    }
+    return m == 0;
+}
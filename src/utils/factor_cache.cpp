@@ -0,0 +1,369 @@
+#include "../../include/utils/factor_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MK_HAVE_MMAP 1
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char kMagic[8] = {'M', 'K', 'L', 'U', 'v', '1', 0, 0};
+    const char kSuffix[] = ".mklu";
+    const size_t kHeaderSize = 64;
+
+    // 文件头，固定 64 字节，各偏移相对文件开头
+    struct FileHeader
+    {
+        char magic[8];
+        uint64_t keyLo;
+        uint64_t keyHi;
+        int64_t n;
+        uint64_t permOffset;
+        uint64_t luOffset;
+        uint64_t fileSize;
+        uint64_t reserved;
+    };
+    static_assert(sizeof(FileHeader) == kHeaderSize, "FileHeader 须为 64 字节");
+
+    // LU 因子按 64 字节对齐，映射后可直接做向量化读取
+    uint64_t luOffset(int n)
+    {
+        const uint64_t end = kHeaderSize + sizeof(int32_t) * static_cast<uint64_t>(n);
+        return (end + 63) / 64 * 64;
+    }
+
+    uint64_t fileSize(int n)
+    {
+        return luOffset(n) + sizeof(double) * static_cast<uint64_t>(n) * n;
+    }
+
+    // splitmix64 的终混函数
+    uint64_t mix(uint64_t h)
+    {
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+#ifdef MK_HAVE_MMAP
+    // 逐级创建目录 (同 mkdir -p)，已存在时视为成功
+    bool makeDirectories(const std::string &directory)
+    {
+        for (size_t pos = 1; pos <= directory.size(); ++pos)
+        {
+            if (pos < directory.size() && directory[pos] != '/')
+            {
+                continue;
+            }
+            const std::string prefix = directory.substr(0, pos);
+            if (mkdir(prefix.c_str(), 0755) != 0 && errno != EEXIST)
+            {
+                return false;
+            }
+        }
+        struct stat st;
+        return stat(directory.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+    }
+#endif
+
+    // 两路独立的逐字哈希，合起来为 128 位
+    struct Hasher
+    {
+        uint64_t a = 0x243f6a8885a308d3ULL;
+        uint64_t b = 0x13198a2e03707344ULL;
+
+        void add(uint64_t word)
+        {
+            a = (a ^ word) * 0x100000001b3ULL;
+            b = (b ^ word) * 0x9e3779b97f4a7c15ULL + 0x632be59bd9b4e019ULL;
+        }
+
+        void add(const void *data, size_t bytes)
+        {
+            const unsigned char *p = static_cast<const unsigned char *>(data);
+            for (; bytes >= 8; bytes -= 8, p += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, p, 8);
+                add(word);
+            }
+            uint64_t tail = bytes;
+            for (size_t t = 0; t < bytes; ++t)
+            {
+                tail = tail << 8 | p[t];
+            }
+            add(tail);
+        }
+    };
+}
+
+std::string FactorCache::Key::hex() const
+{
+    char text[33];
+    std::snprintf(text, sizeof(text), "%016llx%016llx",
+                  static_cast<unsigned long long>(hi), static_cast<unsigned long long>(lo));
+    return text;
+}
+
+FactorCache::Entry::~Entry()
+{
+#ifdef MK_HAVE_MMAP
+    if (address_)
+    {
+        munmap(address_, length_);
+    }
+#endif
+}
+
+FactorCache::FactorCache(const std::string &directory, uint64_t maxBytes, int maxEntries)
+    : directory_(directory), maxBytes_(maxBytes), maxEntries_(maxEntries)
+{
+}
+
+std::string FactorCache::path(const Key &key) const
+{
+    return directory_ + "/" + key.hex() + kSuffix;
+}
+
+FactorCache::Key FactorCache::hash(const LinearOperator &op, const std::string &settings)
+{
+    const int n = op.size();
+    std::vector<uint64_t> rowHash(2 * static_cast<size_t>(n));
+
+    // 行哈希互相独立，最后按行号顺序合并
+#pragma omp parallel
+    {
+        std::vector<double> row(n);
+#pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i)
+        {
+            op.copyRow(i, row.data());
+            Hasher h;
+            h.add(row.data(), sizeof(double) * n);
+            rowHash[2 * static_cast<size_t>(i)] = h.a;
+            rowHash[2 * static_cast<size_t>(i) + 1] = h.b;
+        }
+    }
+
+    Hasher h;
+    h.add(static_cast<uint64_t>(n));
+    h.add(settings.data(), settings.size());
+    for (uint64_t word : rowHash)
+    {
+        h.add(word);
+    }
+
+    Key key;
+    key.lo = mix(h.a);
+    key.hi = mix(h.b ^ key.lo);
+    return key;
+}
+
+std::shared_ptr<const FactorCache::Entry> FactorCache::load(const Key &key, int n) const
+{
+#ifdef MK_HAVE_MMAP
+    const std::string file = path(key);
+    const int fd = open(file.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat st;
+    void *address = MAP_FAILED;
+    const uint64_t expected = fileSize(n);
+    if (fstat(fd, &st) == 0 && static_cast<uint64_t>(st.st_size) == expected)
+    {
+        address = mmap(nullptr, expected, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd); // 映射不依赖文件描述符
+    if (address == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    std::shared_ptr<Entry> entry(new Entry());
+    entry->address_ = address;
+    entry->length_ = expected;
+
+    FileHeader header;
+    std::memcpy(&header, address, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.keyLo != key.lo ||
+        header.keyHi != key.hi || header.n != n || header.permOffset != kHeaderSize ||
+        header.luOffset != luOffset(n) || header.fileSize != expected)
+    {
+        return nullptr; // entry 析构时解除映射
+    }
+
+    const char *base = static_cast<const char *>(address);
+    entry->n_ = n;
+    entry->perm_ = reinterpret_cast<const int *>(base + header.permOffset);
+    entry->lu_ = reinterpret_cast<const double *>(base + header.luOffset);
+
+    // 刷新修改时间作为最近使用时间，淘汰时据此排序
+    utimensat(AT_FDCWD, file.c_str(), nullptr, 0);
+    return entry;
+#else
+    (void)key;
+    (void)n;
+    return nullptr;
+#endif
+}
+
+bool FactorCache::store(const Key &key, int n, const int *perm, const double *lu)
+{
+#ifdef MK_HAVE_MMAP
+    const uint64_t size = fileSize(n);
+    if (maxBytes_ > 0 && size > maxBytes_)
+    {
+        std::cerr << "警告：LU 分解大小 " << size / 1048576.0 << " MB 超过缓存上限 "
+                  << maxBytes_ / 1048576.0 << " MB，未写入缓存" << std::endl;
+        return false;
+    }
+    if (!makeDirectories(directory_))
+    {
+        std::cerr << "警告：无法创建缓存目录 " << directory_ << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.keyLo = key.lo;
+    header.keyHi = key.hi;
+    header.n = n;
+    header.permOffset = kHeaderSize;
+    header.luOffset = luOffset(n);
+    header.fileSize = size;
+
+    const std::string file = path(key);
+    const std::string temp = file + ".tmp." + std::to_string(getpid());
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            std::cerr << "警告：无法创建缓存文件 " << temp << std::endl;
+            return false;
+        }
+        const char padding[64] = {};
+        std::vector<int32_t> order(perm, perm + n);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(order.data()), sizeof(int32_t) * n);
+        out.write(padding, header.luOffset - kHeaderSize - sizeof(int32_t) * n);
+        out.write(reinterpret_cast<const char *>(lu), sizeof(double) * static_cast<size_t>(n) * n);
+        out.close();
+        if (!out)
+        {
+            std::cerr << "警告：写入缓存文件 " << temp << " 失败" << std::endl;
+            std::remove(temp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temp.c_str(), file.c_str()) != 0)
+    {
+        std::cerr << "警告：无法重命名缓存文件为 " << file << ": " << std::strerror(errno) << std::endl;
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    evict(&key);
+    return true;
+#else
+    (void)key;
+    (void)n;
+    (void)perm;
+    (void)lu;
+    return false;
+#endif
+}
+
+int FactorCache::evict(const Key *keep)
+{
+#ifdef MK_HAVE_MMAP
+    if (maxBytes_ == 0 && maxEntries_ == 0)
+    {
+        return 0;
+    }
+
+    struct Item
+    {
+        std::string name;
+        uint64_t bytes;
+        long long mtime; // 纳秒
+    };
+    std::vector<Item> items;
+    uint64_t total = 0;
+
+    DIR *dir = opendir(directory_.c_str());
+    if (!dir)
+    {
+        return 0;
+    }
+    const size_t suffixLength = sizeof(kSuffix) - 1;
+    while (dirent *e = readdir(dir))
+    {
+        const std::string name = e->d_name;
+        if (name.size() <= suffixLength || name.compare(name.size() - suffixLength, suffixLength, kSuffix) != 0)
+        {
+            continue;
+        }
+        struct stat st;
+        if (stat((directory_ + "/" + name).c_str(), &st) != 0)
+        {
+            continue;
+        }
+        long long mtime = static_cast<long long>(st.st_mtime) * 1000000000LL;
+#ifdef __linux__
+        mtime += st.st_mtim.tv_nsec;
+#endif
+        items.push_back(Item{name, static_cast<uint64_t>(st.st_size), mtime});
+        total += st.st_size;
+    }
+    closedir(dir);
+
+    std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+        return a.mtime != b.mtime ? a.mtime < b.mtime : a.name < b.name;
+    });
+
+    const std::string kept = keep ? keep->hex() + kSuffix : std::string();
+    int count = items.size();
+    int removed = 0;
+    for (const Item &item : items)
+    {
+        const bool overBytes = maxBytes_ > 0 && total > maxBytes_;
+        const bool overEntries = maxEntries_ > 0 && count > maxEntries_;
+        if (!overBytes && !overEntries)
+        {
+            break;
+        }
+        if (item.name == kept)
+        {
+            continue;
+        }
+        if (unlink((directory_ + "/" + item.name).c_str()) == 0)
+        {
+            total -= item.bytes;
+            --count;
+            ++removed;
+        }
+    }
+    return removed;
+#else
+    (void)keep;
+    return 0;
+#endif
+}
@@ -0,0 +1,195 @@
+#include "../../include/utils/parallel.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace
+{
+    // 解析 "0-3,8-11" 形式的 CPU 列表
+    std::vector<int> parseCpuList(const std::string &str)
+    {
+        std::vector<int> cpus;
+        std::stringstream ss(str);
+        std::string item;
+        while (std::getline(ss, item, ','))
+        {
+            if (item.empty())
+                continue;
+            auto dash = item.find('-');
+            int first = std::stoi(item.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+        return cpus;
+    }
+
+    // 读取每个 NUMA 节点的 CPU 列表，仅保留当前进程允许使用的 CPU
+    std::vector<std::vector<int> > readNodeCpus()
+    {
+        std::vector<std::vector<int> > nodes;
+#ifdef __linux__
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        bool haveMask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+        for (int node = 0;; ++node)
+        {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!file.is_open())
+                break;
+            std::string line;
+            std::getline(file, line);
+
+            std::vector<int> cpus;
+            for (int cpu : parseCpuList(line))
+                if (!haveMask || CPU_ISSET(cpu, &allowed))
+                    cpus.push_back(cpu);
+            if (!cpus.empty())
+                nodes.push_back(cpus);
+        }
+
+        if (nodes.empty() && haveMask)
+        {
+            std::vector<int> cpus;
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+                if (CPU_ISSET(cpu, &allowed))
+                    cpus.push_back(cpu);
+            nodes.push_back(cpus);
+        }
+#endif
+        if (nodes.empty())
+        {
+            std::vector<int> cpus;
+            unsigned count = std::thread::hardware_concurrency();
+            for (unsigned cpu = 0; cpu < (count ? count : 1); ++cpu)
+                cpus.push_back(static_cast<int>(cpu));
+            nodes.push_back(cpus);
+        }
+        return nodes;
+    }
+
+    // 计算第 tid 个线程 (共 nthreads 个) 应绑定的 CPU
+    int pickCpu(const std::vector<std::vector<int> > &nodes, AffinityMode mode,
+                int tid, int nthreads)
+    {
+        if (mode == AffinityMode::Compact)
+        {
+            std::vector<int> all;
+            for (const auto &cpus : nodes)
+                all.insert(all.end(), cpus.begin(), cpus.end());
+            return all[tid % all.size()];
+        }
+
+        // scatter: 线程轮流分配到各节点，节点内再均匀铺开
+        const int nodeCount = static_cast<int>(nodes.size());
+        const int node = tid % nodeCount;
+        const int slot = tid / nodeCount;
+        const int threadsOnNode = (nthreads - node + nodeCount - 1) / nodeCount;
+        const auto &cpus = nodes[node];
+        size_t index = static_cast<size_t>(slot) * cpus.size() / (threadsOnNode > 0 ? threadsOnNode : 1);
+        return cpus[index % cpus.size()];
+    }
+}
+
+bool parseAffinityMode(const std::string &name, AffinityMode &mode)
+{
+    if (name == "none")
+        mode = AffinityMode::None;
+    else if (name == "compact")
+        mode = AffinityMode::Compact;
+    else if (name == "scatter")
+        mode = AffinityMode::Scatter;
+    else
+        return false;
+    return true;
+}
+
+const char *affinityModeName(AffinityMode mode)
+{
+    switch (mode)
+    {
+    case AffinityMode::Compact:
+        return "compact";
+    case AffinityMode::Scatter:
+        return "scatter";
+    default:
+        return "none";
+    }
+}
+
+void setupThreads(int threads, AffinityMode mode)
+{
+#ifdef _OPENMP
+    if (threads > 0)
+        omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+
+    if (mode == AffinityMode::None)
+        return;
+
+#ifdef __linux__
+    const auto nodes = readNodeCpus();
+    bool failed = false;
+
+    // OpenMP 线程池在线程数不变时会复用同一批线程，绑定一次即可持续生效
+#pragma omp parallel
+    {
+        int tid = 0;
+        int nthreads = 1;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+        nthreads = omp_get_num_threads();
+#endif
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(pickCpu(nodes, mode, tid, nthreads), &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0)
+        {
+#pragma omp critical
+            failed = true;
+        }
+    }
+
+    if (failed)
+        std::cerr << "警告：线程绑定失败，将由操作系统调度" << std::endl;
+#else
+    std::cerr << "警告：当前平台不支持线程绑定" << std::endl;
+#endif
+}
+
+int threadCount()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+void firstTouchCopy(double *dst, const double *src, size_t n)
+{
+    const int count = static_cast<int>(n);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < count; ++i)
+        dst[i] = src[i];
+}
+
+void firstTouchFill(double *dst, double value, size_t n)
+{
+    const int count = static_cast<int>(n);
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < count; ++i)
+        dst[i] = value;
+}
@@ -0,0 +1,145 @@
+#include "../../include/utils/perf_counters.h"
+#include "../../include/utils/parallel.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const int kEventCount = 4;
+
+    int currentThread()
+    {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+#ifdef __linux__
+    // 顺序与 Counts 的字段一致
+    const uint64_t kEvents[kEventCount] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_REFERENCES,
+        PERF_COUNT_HW_CACHE_MISSES};
+
+    int openEvent(uint64_t config)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // pid = 0, cpu = -1: 统计调用线程，不限 CPU
+        return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    double readEvent(int fd)
+    {
+        uint64_t data[3] = {0, 0, 0}; // value, time_enabled, time_running
+        if (fd < 0 || read(fd, data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)))
+            return 0.0;
+        if (data[2] == 0)
+            return 0.0;
+        return static_cast<double>(data[0]) * data[1] / data[2];
+    }
+#endif
+}
+
+PerfCounters::PerfCounters()
+{
+#ifdef __linux__
+    fds_.assign(threadCount(), std::vector<int>(kEventCount, -1));
+    bool cyclesOpened = false;
+
+    // 在每个线程中为其自身打开计数器
+#pragma omp parallel
+    {
+        const int tid = currentThread();
+        if (tid < static_cast<int>(fds_.size()))
+        {
+            for (int e = 0; e < kEventCount; ++e)
+                fds_[tid][e] = openEvent(kEvents[e]);
+            if (fds_[tid][0] >= 0)
+            {
+#pragma omp critical
+                cyclesOpened = true;
+            }
+        }
+    }
+    available_ = cyclesOpened;
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (const auto &thread : fds_)
+        for (int fd : thread)
+            if (fd >= 0)
+                close(fd);
+#endif
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    if (!available_)
+        return;
+    for (const auto &thread : fds_)
+    {
+        for (int fd : thread)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+#endif
+}
+
+PerfCounters::Counts PerfCounters::stop()
+{
+    Counts counts;
+#ifdef __linux__
+    if (!available_)
+        return counts;
+
+    double totals[kEventCount] = {0.0, 0.0, 0.0, 0.0};
+    for (const auto &thread : fds_)
+    {
+        for (int e = 0; e < kEventCount; ++e)
+        {
+            if (thread[e] >= 0)
+            {
+                ioctl(thread[e], PERF_EVENT_IOC_DISABLE, 0);
+                totals[e] += readEvent(thread[e]);
+            }
+        }
+    }
+    counts.cycles = totals[0];
+    counts.instructions = totals[1];
+    counts.llcReferences = totals[2];
+    counts.llcMisses = totals[3];
+#endif
+    return counts;
+}